@@ -0,0 +1,146 @@
+/*
+ * Benchmark del trasferimento dati verso il display.
+ * Misura il tempo di clear() e di una schermata di testo completa (6 righe x 14 caratteri) e
+ * lo confronta con un invio di riferimento byte per byte (SPI.transfer(b) per ogni byte), a parità
+ * di byte e di frequenza SPI. I risultati vengono stampati sulla seriale in byte/s.
+ * Confronta inoltre, in cicli di CPU, setCursor() + una stringa di 5 caratteri tra PCD8544 (pin a runtime,
+ * digitalWrite) e PCD8544Fast (pin a compile-time, scrittura diretta dei registri).
+ * Infine confronta il testo ingrandito 2x da MONO_5x7 (setTextScale) con il font nativo 10x16 px,
+ * che produce gli stessi pixel, e con la sua versione compressa (extras/tools/fontpack.py):
+ * cicli per drawText() e byte di flash occupati.
+ * Pin pensati per Arduino Uno/Nano; per ESP32 adattare i numeri dei GPIO.
+ */
+#include <Arduino.h>
+#include <SPI.h>
+#include <PCD8544.h>
+#include <font/mono_5x8px/data.h>
+#include <font/mono_5x8px/meta.h>
+#include <font/digits_10x16px/data.h>
+#include <font/digits_10x16px/meta.h>
+#include <font/digits_10x16px_packed/data.h>
+#include <font/digits_10x16px_packed/meta.h>
+
+#define SCK 13
+#define MOSI 11
+#define LCD_CS 10
+#define LCD_DC 9
+#define LCD_RST 8
+#define LCD_BL 5
+
+#define SPI_HZ 4000000
+#define ROUNDS 50
+
+PCD8544 lcd(SPI, {SCK, MOSI, LCD_CS, LCD_DC, LCD_RST, LCD_BL}, SPI_HZ, SPI_MODE0);
+PCD8544Fast<LCD_CS, LCD_DC, LCD_RST> lcdFast(SPI, SCK, MOSI, LCD_BL, SPI_HZ, SPI_MODE0);
+
+// Contatore di cicli: registro CCOUNT su ESP32, altrimenti micros() scalato su F_CPU
+#if defined(ARDUINO_ARCH_ESP32)
+  #define CYCLES() ((uint32_t)ESP.getCycleCount())
+#else
+  #define CYCLES() ((uint32_t)(micros() * (F_CPU / 1000000UL)))
+#endif
+
+// Stampa una riga di risultato: nome, tempo medio per round, byte/s
+void report (const char* name, uint32_t us, uint32_t bytesPerRound) {
+    const uint32_t perRound = us / ROUNDS;
+    const uint32_t bps = (uint32_t)((uint64_t)bytesPerRound * ROUNDS * 1000000ULL / (us ? us : 1));
+    Serial.print(name);
+    Serial.print(F(": "));
+    Serial.print(perRound);
+    Serial.print(F(" us/round, "));
+    Serial.print(bps);
+    Serial.println(F(" B/s"));
+}
+
+// Riferimento: 504 byte inviati uno alla volta, come faceva clear() prima dei trasferimenti a blocco
+uint32_t referencePerByte () {
+    const uint32_t t0 = micros();
+    for (uint8_t r = 0; r < ROUNDS; r++) {
+        SPI.beginTransaction(SPISettings(SPI_HZ, MSBFIRST, SPI_MODE0));
+        digitalWrite(LCD_DC, HIGH);
+        digitalWrite(LCD_CS, LOW);
+        for (uint16_t i = 0; i < MAX_BUFFER; i++) SPI.transfer(0x00);
+        digitalWrite(LCD_CS, HIGH);
+        SPI.endTransaction();
+    }
+    return micros() - t0;
+}
+
+uint32_t benchClear () {
+    const uint32_t t0 = micros();
+    for (uint8_t r = 0; r < ROUNDS; r++) lcd.clear();
+    return micros() - t0;
+}
+
+uint32_t benchText () {
+    const uint32_t t0 = micros();
+    for (uint8_t r = 0; r < ROUNDS; r++) {
+        for (uint8_t row = 0; row < PAGES; row++) {
+            lcd.setCursor(0, row);
+            lcd.print("ABCDEFGHIJKLMN");
+        }
+    }
+    return micros() - t0;
+}
+
+// Cicli medi per setCursor() + print() di 5 caratteri
+template <class LCD>
+uint32_t benchCursorAndGlyphs (LCD& d) {
+    const uint32_t c0 = CYCLES();
+    for (uint8_t r = 0; r < ROUNDS; r++) {
+        d.setCursor(0, 0);
+        d.print("ABCDE");
+    }
+    return (CYCLES() - c0) / ROUNDS;
+}
+
+// Cicli medi per drawText() di "12:34" alto 16 px, con il font e la scala correnti
+uint32_t benchBigDigits () {
+    const uint32_t c0 = CYCLES();
+    for (uint8_t r = 0; r < ROUNDS; r++) lcd.drawText(10, 20, "12:34");
+    return (CYCLES() - c0) / ROUNDS;
+}
+
+void setup () {
+    Serial.begin(115200);
+    delay(2000);
+    lcd.begin(30, 50, 4, 2);
+    lcd.setFont(MONO_5x7);
+
+    Serial.println(F("PCD8544 benchmark"));
+    report("reference per-byte 504 B", referencePerByte(), MAX_BUFFER);
+    report("clear()", benchClear(), MAX_BUFFER);
+    report("full-screen text 6x14", benchText(), PAGES * 14 * (GLYPH_WIDTH + GLYPH_SPACING));
+
+    lcdFast.begin(30, 50, 4, 2);   // stesso display: reinizializza con i pin a compile-time
+    lcdFast.setFont(MONO_5x7);
+    Serial.print(F("setCursor + 5 glyphs, PCD8544:     "));
+    Serial.print(benchCursorAndGlyphs(lcd));
+    Serial.println(F(" cycles"));
+    Serial.print(F("setCursor + 5 glyphs, PCD8544Fast: "));
+    Serial.print(benchCursorAndGlyphs(lcdFast));
+    Serial.println(F(" cycles"));
+
+    lcd.setFont(MONO_5x7);
+    lcd.setTextScale(2);
+    Serial.print(F("drawText 12:34, MONO_5x7 x2:   "));
+    Serial.print(benchBigDigits());
+    Serial.print(F(" cycles, flash "));
+    Serial.print(sizeof(pcd8544::bits::SPREAD2));
+    Serial.println(F(" B (spread table)"));
+    lcd.setTextScale(1);
+    lcd.setFont(DIGITS_10x16);
+    Serial.print(F("drawText 12:34, DIGITS_10x16:  "));
+    Serial.print(benchBigDigits());
+    Serial.print(F(" cycles, flash "));
+    Serial.print(sizeof(DIGITS_10x16_DATA));
+    Serial.println(F(" B (font data)"));
+    lcd.setFont(DIGITS_10x16_PACKED);
+    Serial.print(F("drawText 12:34, DIGITS_10x16_PACKED: "));
+    Serial.print(benchBigDigits());
+    Serial.print(F(" cycles, flash "));
+    Serial.print(sizeof(DIGITS_10x16_PACKED_DATA) + sizeof(DIGITS_10x16_PACKED_INDEX) + sizeof(DIGITS_10x16_PACKED_DICT));
+    Serial.println(F(" B (packed)"));
+}
+
+void loop () {}
@@ -11,6 +11,7 @@
 #include <font/mono_5x8px/data.h>
 #include <font/mono_5x8px/meta.h>
 #include <menu/menu.h>
+#include <gfx/TextField.h>
 
 #define SCK 13
 #define MOSI 11
@@ -23,21 +24,6 @@
 #define SELECT_BTN A1
 #define FORWARD_BTN A2
 
-// ottiene il numero di cifre di un numero
-uint8_t getDigits (int num) {
-    if (num == 0) return 1;
-    uint8_t i = 0;
-    while (num != 0) {
-        num /= 10;
-        i++;
-    }
-    return i;
-};
-
-// Calcola la x di partenza per centrare il testo
-uint8_t calcAbscissaToCenter (uint8_t strLen, uint8_t maxLen) {
-    return (uint8_t)((uint16_t)(maxLen - (uint16_t)(strLen * (GLYPH_WIDTH + GLYPH_SPACING))) / (uint16_t)2);
-}
 
 PCD8544 lcd(SPI, {SCK, MOSI, LCD_CS, LCD_DC, LCD_RST, LCD_BL}, 1000000, SPI_MODE0);
 MenuController menu({
@@ -63,7 +49,7 @@ bool inContrast = false;
 bool inBrightness = false;
 
 const MenuItem ContrastItem ("Contrasto", onContrast, nullptr, 0);  // Voce: Contrasto
-const MenuItem BrightnessItem ("Luminosita", onBrightness, nullptr, 0); // Voce: Luminosita
+const MenuItem BrightnessItem ("Luminosità", onBrightness, nullptr, 0); // Voce: Luminosità
 const MenuItem BiasItem ("Bias", onBias, nullptr, 0);   // Voce: Bias
 const MenuItem TCItem ("TC", onTC, nullptr, 0); // Voce: TC
 
@@ -98,21 +84,36 @@ const MenuItem rootMenu("Main Menu", nullptr, mainMenuItems, sizeof(mainMenuItem
 
 
 /* COMMON SETTING ACTIONS */
-// Render setting
-void renderSetting (const char* label, uint16_t curVal) {
-    lcd.clear();
-    delay(25);
-    lcd.printStringCentered(label, 0);
-    uint8_t valL = getDigits(curVal);
-    uint8_t xval = calcAbscissaToCenter((valL + 4), COLUMNS);
-    lcd.setCursor(xval, 2);
-    lcd.print("- ");
-    lcd.print(curVal);
-    lcd.print(" +"); 
+// Titoli delle impostazioni, renderizzati in compilazione: a ogni ridisegno vengono solo copiati dalla flash
+PCD8544_STATIC_TEXT(TITLE_CONTRAST, MONO_5x7, "Contrasto");
+PCD8544_STATIC_TEXT(TITLE_BRIGHTNESS, MONO_5x7, "Luminosità");
+PCD8544_STATIC_TEXT(TITLE_BIAS, MONO_5x7, "Bias");
+PCD8544_STATIC_TEXT(TITLE_TC, MONO_5x7, "TC");
+
+// Valore dell'impostazione: "- 123 +" centrato sulla riga 2, le cifre in un campo da 3 caratteri
+const uint8_t VALUE_X = (COLUMNS - 7 * (GLYPH_WIDTH + GLYPH_SPACING)) / 2;
+pcd8544::TextField<3> valueField(VALUE_X + 2 * (GLYPH_WIDTH + GLYPH_SPACING), 2);
+const void* shownTitle = nullptr;   // titolo della schermata disegnata (nullptr: da ridisegnare)
+
+// Render setting: all'ingresso disegna l'intera schermata, poi aggiorna solo le cifre cambiate del valore
+template <class Title>
+void renderSetting (const Title& title, uint16_t curVal) {
+    if (shownTitle != &title) {
+        lcd.clear();
+        lcd.drawStatic((uint8_t)((COLUMNS - Title::WIDTH) / 2), 0, title);
+        lcd.setCursor(VALUE_X, 2);
+        lcd.print("-");
+        lcd.setCursor(VALUE_X + 6 * (GLYPH_WIDTH + GLYPH_SPACING), 2);
+        lcd.print("+");
+        valueField.invalidate();
+        shownTitle = &title;
+    }
+    valueField.update(lcd, pcd8544::Number(curVal, {0, 3}));
 } 
 
 // Exit action
-inline void exitAction () { menu.exitAction(); lcd.softRefresh(); }
+// (il refresh si completa in loop() con lcd.poll(), senza attendere i 2 ms del power-down)
+inline void exitAction () { shownTitle = nullptr; menu.exitAction(); lcd.softRefreshAsync(); }
 /* --------------------------------------- */
 
 
@@ -126,7 +127,7 @@ void contrastRight () {
     delay(10);
 }
 void contrastRender () {
-    renderSetting("Contrasto", lcd.getContrast());
+    renderSetting(TITLE_CONTRAST, lcd.getContrast());
 }
 
 void onContrast() {
@@ -149,7 +150,7 @@ void brightnessRight () {
     lcd.backlightLevel(lcd.getBrightness() + 1);
 }
 void brightnessRender () {
-    renderSetting("Luminosita", lcd.getBrightness());
+    renderSetting(TITLE_BRIGHTNESS, lcd.getBrightness());
 }
 void onBrightness() {
     MenuController::Action a;
@@ -170,7 +171,7 @@ void biasRight () {
     lcd.setBias(lcd.getBias() + 1);
 }
 void biasRender () {
-    renderSetting("Bias", lcd.getBias());
+    renderSetting(TITLE_BIAS, lcd.getBias());
 }
 void onBias() {
     MenuController::Action a;
@@ -191,7 +192,7 @@ void tcRight () {
     lcd.setTC(lcd.getTempCoeff() + 1);
 }
 void tcRender () {
-    renderSetting("TC", lcd.getTempCoeff());
+    renderSetting(TITLE_TC, lcd.getTempCoeff());
 }
 void onTC() {
     MenuController::Action a;
@@ -212,9 +213,10 @@ void onBack () {
 /* --------------------------------------- */
 
 void setup() {
+    lcd.beginAsync(30, 50, 4, 2);   // reset e accensione proseguono mentre si inizializza il resto
     Serial.begin(115200);
     delay(2000);
-    lcd.begin(30, 50, 4, 2);
+    while (!lcd.poll()) {}
     delay(500);
     lcd.setFont(MONO_5x7);
     menu.attachDisplay(&lcd);
@@ -224,5 +226,5 @@ void setup() {
 }
 
 void loop() {
-    menu.update();
+    if (lcd.poll()) menu.update();  // niente disegni durante un softRefreshAsync()
 }
\ No newline at end of file
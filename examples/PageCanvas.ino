@@ -0,0 +1,43 @@
+/*
+ * Esempio di rendering a pagine (picture loop) con PageCanvas: un solo buffer da 84 byte in RAM.
+ * La scena viene ridisegnata per ognuna delle 6 pagine del display; sul canvas le primitive si possono
+ * sovrapporre e combinare (OR, AND, XOR, COPY, CLEAR), cosa non possibile con l'API in streaming.
+ */
+#include <Arduino.h>
+#include <SPI.h>
+#include <PCD8544.h>
+#include <gfx/Canvas.h>
+#include <font/mono_5x8px/data.h>
+#include <font/mono_5x8px/meta.h>
+
+#define SCK 13
+#define MOSI 11
+#define LCD_CS 10
+#define LCD_DC 9
+#define LCD_RST 8
+#define LCD_BL 5
+
+using pcd8544::BlendOp;
+
+PCD8544 lcd(SPI, {SCK, MOSI, LCD_CS, LCD_DC, LCD_RST, LCD_BL}, 4000000, SPI_MODE0);
+pcd8544::PageCanvas canvas;
+uint8_t barX = 0;
+
+void setup () {
+    lcd.begin(30, 50, 4, 2);
+    canvas.setFont(MONO_5x7);
+}
+
+void loop () {
+    // Un'unica transazione SPI per tutte le pagine
+    PCD8544::FrameScope frame(lcd);
+    canvas.firstPage();
+    do {
+        canvas.drawRect(0, 0, 84, 48);
+        canvas.fillRect(8, 12, 68, 20);
+        canvas.drawText(18, 18, "PCD8544", BlendOp::XOR);    // testo in negativo sul riquadro
+        canvas.fillRect(barX, 4, 6, 40, BlendOp::XOR);       // barra che scorre sopra a tutto
+    } while (canvas.nextPage(lcd));
+
+    barX = (uint8_t)((barX + 1) % 78);
+}
@@ -0,0 +1,42 @@
+/*
+ * Esempio di display list (pcd8544::Scene): le primitive vengono registrate una volta e si possono
+ * sovrapporre come sul PageCanvas, ma senza buffer dello schermo. A ogni commit() vengono ridisegnate
+ * solo le colonne toccate dalle primitive modificate: qui la barra che scorre (circa 7 colonne per pagina).
+ */
+#include <Arduino.h>
+#include <SPI.h>
+#include <PCD8544.h>
+#include <gfx/Scene.h>
+#include <font/mono_5x8px/data.h>
+#include <font/mono_5x8px/meta.h>
+
+#define SCK 13
+#define MOSI 11
+#define LCD_CS 10
+#define LCD_DC 9
+#define LCD_RST 8
+#define LCD_BL 5
+
+using pcd8544::BlendOp;
+
+PCD8544 lcd(SPI, {SCK, MOSI, LCD_CS, LCD_DC, LCD_RST, LCD_BL}, 4000000, SPI_MODE0);
+pcd8544::Scene<4> scene;
+pcd8544::Scene<4>::Handle bar;
+uint8_t barX = 0;
+
+void setup () {
+    lcd.begin(30, 50, 4, 2);
+    scene.setFont(MONO_5x7);
+    scene.addRect(0, 0, 84, 48);
+    scene.addFillRect(8, 12, 68, 20);
+    scene.addText(18, 18, "PCD8544", BlendOp::XOR);    // testo in negativo sul riquadro
+    bar = scene.addFillRect(barX, 4, 6, 40, BlendOp::XOR);
+    scene.commit(lcd);
+}
+
+void loop () {
+    barX = (uint8_t)((barX + 1) % 78);
+    scene.moveTo(bar, barX, 4);
+    scene.commit(lcd);
+    delay(20);
+}
@@ -0,0 +1,88 @@
+#include "Arduino.h"
+#include "SPI.h"
+#include <stdio.h>
+#include <vector>
+
+SPIClass SPI;
+
+namespace {
+    uint8_t g_level[HOST_NUM_PINS];
+    uint8_t g_mode[HOST_NUM_PINS];
+    void (*g_isr[HOST_NUM_PINS])() = {nullptr};
+    std::vector<arduino_host::PinListener*> g_listeners;
+    uint64_t g_micros = 0;
+
+    void setLevel (uint8_t pin, uint8_t level) {
+        if (pin >= HOST_NUM_PINS) return;
+        level = level ? HIGH : LOW;
+        if (g_level[pin] == level) return;
+        g_level[pin] = level;
+        for (auto* l : g_listeners) l->onPinChange(pin, level);
+    }
+}
+
+namespace arduino_host {
+    void addPinListener (PinListener* l) { g_listeners.push_back(l); }
+    void removePinListener (PinListener* l) {
+        for (size_t i = 0; i < g_listeners.size(); i++) {
+            if (g_listeners[i] == l) { g_listeners.erase(g_listeners.begin() + i); return; }
+        }
+    }
+    uint8_t pinLevel (uint8_t pin) { return pin < HOST_NUM_PINS ? g_level[pin] : LOW; }
+    void setInputLevel (uint8_t pin, uint8_t level) {
+        if (pin >= HOST_NUM_PINS) return;
+        const uint8_t prev = g_level[pin];
+        setLevel(pin, level);
+        if (prev != g_level[pin] && g_isr[pin]) g_isr[pin]();
+    }
+    void advanceMicros (uint32_t us) { g_micros += us; }
+    void resetClock () { g_micros = 0; }
+}
+
+void pinMode (uint8_t pin, uint8_t mode) {
+    if (pin >= HOST_NUM_PINS) return;
+    g_mode[pin] = mode;
+    if (mode == INPUT_PULLUP) setLevel(pin, HIGH);
+}
+void digitalWrite (uint8_t pin, uint8_t val) { setLevel(pin, val); }
+int digitalRead (uint8_t pin) { return arduino_host::pinLevel(pin); }
+void analogWrite (uint8_t pin, int val) { (void)pin; (void)val; }
+
+unsigned long millis () { return (unsigned long)(g_micros / 1000); }
+unsigned long micros () { return (unsigned long)g_micros; }
+void delay (unsigned long ms) { g_micros += (uint64_t)ms * 1000; }
+void delayMicroseconds (unsigned int us) { g_micros += us; }
+
+void attachInterrupt (int irq, void (*isr)(), int mode) {
+    (void)mode;
+    if (irq >= 0 && irq < HOST_NUM_PINS) g_isr[irq] = isr;
+}
+void detachInterrupt (int irq) {
+    if (irq >= 0 && irq < HOST_NUM_PINS) g_isr[irq] = nullptr;
+}
+
+char* utoa (unsigned int value, char* str, int base) {
+    char tmp[33];
+    int i = 0;
+    do {
+        const unsigned int d = value % (unsigned int)base;
+        tmp[i++] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+        value /= (unsigned int)base;
+    } while (value);
+    int j = 0;
+    while (i) str[j++] = tmp[--i];
+    str[j] = '\0';
+    return str;
+}
+char* itoa (int value, char* str, int base) {
+    if (value < 0 && base == 10) {
+        str[0] = '-';
+        utoa((unsigned int)(-(long)value), str + 1, base);
+        return str;
+    }
+    return utoa((unsigned int)value, str, base);
+}
+char* dtostrf (double val, signed char width, unsigned char prec, char* s) {
+    sprintf(s, "%*.*f", width, prec, val);
+    return s;
+}
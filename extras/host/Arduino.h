@@ -0,0 +1,85 @@
+#pragma once
+/*
+ * ** Arduino.h (host) **
+ * Sostituto minimale del core Arduino per compilare la libreria su Linux/macOS.
+ * Fornisce solo ciò che serve a src/: gestione pin, tempo virtuale, conversioni numeriche
+ * e PROGMEM "finto". Lo stato dei pin è osservabile tramite PinListener, così un modello
+ * hardware (es. PCD8544Emu) può reagire a CS/DC/RST senza modificare il codice della libreria.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT           0x0
+#define OUTPUT          0x1
+#define INPUT_PULLUP    0x2
+#define INPUT_PULLDOWN  0x9
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define NOT_AN_INTERRUPT -1
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HOST_NUM_PINS 64
+
+namespace arduino_host {
+    // Osservatore dei cambi di livello sui pin (chiamato solo quando il livello cambia)
+    struct PinListener {
+        virtual void onPinChange (uint8_t pin, uint8_t level) = 0;
+        virtual ~PinListener () = default;
+    };
+
+    void addPinListener (PinListener* l);
+    void removePinListener (PinListener* l);
+    uint8_t pinLevel (uint8_t pin);
+    // Forza il livello letto da digitalRead (ingressi simulati)
+    void setInputLevel (uint8_t pin, uint8_t level);
+
+    // Tempo virtuale: avanza solo tramite delay()/delayMicroseconds()/advanceMicros()
+    void advanceMicros (uint32_t us);
+    void resetClock ();
+}
+
+void pinMode (uint8_t pin, uint8_t mode);
+void digitalWrite (uint8_t pin, uint8_t val);
+int digitalRead (uint8_t pin);
+void analogWrite (uint8_t pin, int val);
+
+unsigned long millis ();
+unsigned long micros ();
+void delay (unsigned long ms);
+void delayMicroseconds (unsigned int us);
+
+inline int digitalPinToInterrupt (uint8_t pin) { return pin; }
+void attachInterrupt (int irq, void (*isr)(), int mode);
+void detachInterrupt (int irq);
+inline void noInterrupts () {}
+inline void interrupts () {}
+
+char* itoa (int value, char* str, int base);
+char* utoa (unsigned int value, char* str, int base);
+char* dtostrf (double val, signed char width, unsigned char prec, char* s);
@@ -0,0 +1,136 @@
+#include "PCD8544Emu.h"
+
+namespace pcd8544 {
+
+PCD8544Emu::Counters PCD8544Emu::Counters::operator- (const Counters& o) const {
+    Counters r;
+    r.dataBytes = dataBytes - o.dataBytes;
+    r.cmdBytes = cmdBytes - o.cmdBytes;
+    r.droppedBytes = droppedBytes - o.droppedBytes;
+    r.csCycles = csCycles - o.csCycles;
+    r.dcToggles = dcToggles - o.dcToggles;
+    r.transactions = transactions - o.transactions;
+    r.transferCalls = transferCalls - o.transferCalls;
+    return r;
+}
+
+PCD8544Emu::PCD8544Emu (SPIClass& spi, uint8_t cs, uint8_t dc, uint8_t rst)
+    : _spi(spi), _cs(cs), _dc(dc), _rst(rst) {
+    memset(_ram, 0, sizeof(_ram));
+    reset();
+    _spi.attachDevice(this);
+    arduino_host::addPinListener(this);
+}
+
+PCD8544Emu::~PCD8544Emu () {
+    _spi.attachDevice(nullptr);
+    arduino_host::removePinListener(this);
+}
+
+/*
+ *  Reset hardware: la DDRAM non viene azzerata (contenuto indefinito sul chip reale),
+ *  i registri tornano ai valori di power-on.
+ */
+void PCD8544Emu::reset () {
+    _x = 0; _y = 0;
+    _h = false; _v = false; _pd = true;
+    _dispMode = 0x08;
+    _vop = 0; _bias = 0; _tc = 0;
+}
+
+bool PCD8544Emu::pixel (uint8_t x, uint8_t y) const {
+    if (x >= RAM_COLUMNS || y >= RAM_PAGES * 8) return false;
+    return (_ram[y >> 3][x] >> (y & 7)) & 1;
+}
+
+void PCD8544Emu::fillRam (uint8_t v) {
+    memset(_ram, v, sizeof(_ram));
+}
+
+std::string PCD8544Emu::render () const {
+    std::string s;
+    s.reserve((RAM_COLUMNS + 1) * RAM_PAGES * 8);
+    for (uint8_t y = 0; y < RAM_PAGES * 8; y++) {
+        for (uint8_t x = 0; x < RAM_COLUMNS; x++) s += pixel(x, y) ? '#' : '.';
+        s += '\n';
+    }
+    return s;
+}
+
+void PCD8544Emu::onBeginTransaction (const SPISettings&) {
+    _inTransaction = true;
+    _cnt.transactions++;
+}
+
+void PCD8544Emu::onEndTransaction () {
+    _inTransaction = false;
+}
+
+void PCD8544Emu::onTransferCall (size_t) {
+    _cnt.transferCalls++;
+}
+
+uint8_t PCD8544Emu::onTransfer (uint8_t b) {
+    if (arduino_host::pinLevel(_cs) != LOW || arduino_host::pinLevel(_rst) == LOW) {
+        _cnt.droppedBytes++;
+        return 0xFF;
+    }
+    if (arduino_host::pinLevel(_dc) == HIGH) {
+        _cnt.dataBytes++;
+        data(b);
+    } else {
+        _cnt.cmdBytes++;
+        command(b);
+    }
+    return 0xFF;    // MISO non collegato
+}
+
+void PCD8544Emu::onPinChange (uint8_t pin, uint8_t level) {
+    if (pin == _cs && level == LOW) _cnt.csCycles++;
+    if (pin == _dc) _cnt.dcToggles++;
+    if (pin == _rst && level == LOW) reset();
+}
+
+void PCD8544Emu::command (uint8_t c) {
+    // Function Set: comune ai due set di istruzioni (0010 0PVH)
+    if ((c & 0xF8) == 0x20) {
+        _pd = c & 0x04;
+        _v = c & 0x02;
+        _h = c & 0x01;
+        return;
+    }
+    if (c == 0x00) return;  // NOP
+
+    if (!_h) {
+        if (c & 0x80) {                     // Set X (0..83)
+            const uint8_t x = c & 0x7F;
+            if (x < RAM_COLUMNS) _x = x;
+        } else if (c & 0x40) {              // Set Y (0..5)
+            const uint8_t y = c & 0x07;
+            if (y < RAM_PAGES) _y = y;
+        } else if ((c & 0xFA) == 0x08) {    // Display Control (0000 1D0E)
+            _dispMode = c;
+        }
+    } else {
+        if (c & 0x80) _vop = c & 0x7F;                  // Set Vop
+        else if ((c & 0xF8) == 0x10) _bias = c & 0x07;  // Bias system
+        else if ((c & 0xFC) == 0x04) _tc = c & 0x03;    // Temperature control
+    }
+}
+
+void PCD8544Emu::data (uint8_t d) {
+    _ram[_y][_x] = d;
+    if (!_v) {
+        if (++_x >= RAM_COLUMNS) {
+            _x = 0;
+            if (++_y >= RAM_PAGES) _y = 0;
+        }
+    } else {
+        if (++_y >= RAM_PAGES) {
+            _y = 0;
+            if (++_x >= RAM_COLUMNS) _x = 0;
+        }
+    }
+}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+/*
+ * ** PCD8544Emu **
+ * Modello software del controller PCD8544 da usare su host (CI, benchmark) al posto del display reale.
+ * Si collega al bus SPI finto (SPI.h host) e osserva i pin CS, D/C e RST (Arduino.h host), così il codice
+ * di src/ gira invariato.
+ *
+ * Modella:
+ *  - DDRAM da 504 byte (6 pagine x 84 colonne)
+ *  - contatori di indirizzo X/Y con auto-incremento orizzontale o verticale (bit V del Function Set)
+ *  - set di istruzioni base (H=0) ed esteso (H=1), Display Control, power-down
+ *  - semantica di CS (byte ignorati con CS alto) e D/C (campionato a fine byte)
+ *
+ * Inoltre conta il traffico sul bus: byte dati, byte comando, cicli di CS, commutazioni di D/C,
+ * chiamate a beginTransaction e chiamate di trasferimento SPI. Con measure() si ottiene il costo
+ * di una singola chiamata dell'API.
+ */
+#include <Arduino.h>
+#include <SPI.h>
+#include <string>
+
+namespace pcd8544 {
+
+class PCD8544Emu : public arduino_host::SpiDevice, public arduino_host::PinListener {
+public:
+    static constexpr uint8_t RAM_PAGES = 6;
+    static constexpr uint8_t RAM_COLUMNS = 84;
+
+    struct Counters {
+        uint32_t dataBytes = 0;      // byte scritti in DDRAM (D/C alto)
+        uint32_t cmdBytes = 0;       // byte di comando (D/C basso)
+        uint32_t droppedBytes = 0;   // byte trasferiti con CS alto (ignorati dal controller)
+        uint32_t csCycles = 0;       // fronti di discesa di CS (ogni ciclo = 2 commutazioni)
+        uint32_t dcToggles = 0;      // commutazioni di D/C
+        uint32_t transactions = 0;   // chiamate a beginTransaction
+        uint32_t transferCalls = 0;  // chiamate a transfer()/writeBytes() lato driver
+
+        inline uint32_t busBytes () const { return dataBytes + cmdBytes; }
+        inline uint32_t csToggles () const { return csCycles * 2; }
+        Counters operator- (const Counters& o) const;
+    };
+
+    PCD8544Emu (SPIClass& spi, uint8_t cs, uint8_t dc, uint8_t rst);
+    ~PCD8544Emu ();
+
+    // Stato del controller
+    inline uint8_t x () const { return _x; }
+    inline uint8_t y () const { return _y; }
+    inline bool verticalAddressing () const { return _v; }
+    inline bool extendedSet () const { return _h; }
+    inline bool poweredDown () const { return _pd; }
+    inline uint8_t displayMode () const { return _dispMode; }   // valore DISPLAY_CONTROL (0x08..0x0D)
+    inline uint8_t vop () const { return _vop; }
+    inline uint8_t bias () const { return _bias; }
+    inline uint8_t tempCoeff () const { return _tc; }
+    inline bool inTransaction () const { return _inTransaction; }
+
+    // DDRAM
+    inline uint8_t ram (uint8_t x, uint8_t page) const { return _ram[page][x]; }
+    inline const uint8_t* ram () const { return &_ram[0][0]; }
+    bool pixel (uint8_t x, uint8_t y) const;
+    void fillRam (uint8_t v);
+    // Rappresentazione ASCII del contenuto ('#' = pixel acceso)
+    std::string render () const;
+
+    // Contatori
+    inline const Counters& counters () const { return _cnt; }
+    inline void resetCounters () { _cnt = Counters(); }
+
+    // Esegue f e ritorna il traffico generato
+    template <class F>
+    Counters measure (F&& f) {
+        const Counters before = _cnt;
+        f();
+        return _cnt - before;
+    }
+
+    // SpiDevice
+    void onBeginTransaction (const SPISettings&) override;
+    void onEndTransaction () override;
+    uint8_t onTransfer (uint8_t b) override;
+    void onTransferCall (size_t) override;
+    // PinListener
+    void onPinChange (uint8_t pin, uint8_t level) override;
+
+private:
+    SPIClass& _spi;
+    uint8_t _cs, _dc, _rst;
+    uint8_t _ram[RAM_PAGES][RAM_COLUMNS];
+    uint8_t _x = 0, _y = 0;
+    bool _h = false, _v = false, _pd = true;
+    uint8_t _dispMode = 0x08;
+    uint8_t _vop = 0, _bias = 0, _tc = 0;
+    bool _inTransaction = false;
+    Counters _cnt;
+
+    void reset ();
+    void command (uint8_t c);
+    void data (uint8_t d);
+};
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+/*
+ * ** SPI.h (host) **
+ * SPIClass minimale: ogni byte trasferito viene consegnato a un SpiDevice collegato
+ * (es. PCD8544Emu). Sono presenti sia il trasferimento a singolo byte sia quelli a blocco,
+ * con le stesse firme dei core AVR (transfer(buf, len)) ed ESP32 (writeBytes/transferBytes).
+ */
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings {
+public:
+    SPISettings () : clock(4000000), bitOrder(MSBFIRST), dataMode(SPI_MODE0) {}
+    SPISettings (uint32_t c, uint8_t o, uint8_t m) : clock(c), bitOrder(o), dataMode(m) {}
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+namespace arduino_host {
+    // Periferica collegata al bus: riceve gli eventi del bus SPI
+    struct SpiDevice {
+        virtual void onBeginTransaction (const SPISettings&) {}
+        virtual void onEndTransaction () {}
+        virtual uint8_t onTransfer (uint8_t b) = 0;
+        // una chiamata a transfer()/writeBytes() (a prescindere dal numero di byte)
+        virtual void onTransferCall (size_t) {}
+        virtual ~SpiDevice () = default;
+    };
+}
+
+class SPIClass {
+public:
+    void begin () { _begun = true; }
+    void begin (int8_t sck, int8_t miso, int8_t mosi, int8_t ss = -1) {
+        (void)sck; (void)miso; (void)mosi; (void)ss;
+        _begun = true;
+    }
+    void end () { _begun = false; }
+
+    void beginTransaction (const SPISettings& s) { if (_dev) _dev->onBeginTransaction(s); }
+    void endTransaction () { if (_dev) _dev->onEndTransaction(); }
+
+    uint8_t transfer (uint8_t b) {
+        if (!_dev) return 0;
+        _dev->onTransferCall(1);
+        return _dev->onTransfer(b);
+    }
+    // Trasferimento a blocco in-place (come nel core AVR)
+    void transfer (void* buf, size_t len) {
+        uint8_t* p = static_cast<uint8_t*>(buf);
+        if (!_dev) return;
+        _dev->onTransferCall(len);
+        while (len--) { *p = _dev->onTransfer(*p); p++; }
+    }
+    // Scrittura a blocco senza lettura (come nel core ESP32)
+    void writeBytes (const uint8_t* data, uint32_t len) {
+        if (!_dev) return;
+        _dev->onTransferCall(len);
+        while (len--) _dev->onTransfer(*data++);
+    }
+    void transferBytes (const uint8_t* data, uint8_t* out, uint32_t len) {
+        if (!_dev) return;
+        _dev->onTransferCall(len);
+        for (uint32_t i = 0; i < len; i++) {
+            uint8_t r = _dev->onTransfer(data ? data[i] : 0xFF);
+            if (out) out[i] = r;
+        }
+    }
+
+    inline void attachDevice (arduino_host::SpiDevice* dev) { _dev = dev; }
+    inline bool begun () const { return _begun; }
+
+private:
+    arduino_host::SpiDevice* _dev = nullptr;
+    bool _begun = false;
+};
+
+extern SPIClass SPI;
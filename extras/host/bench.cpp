@@ -0,0 +1,349 @@
+/*
+ * ** bench (host) **
+ * Misura il traffico sul bus generato dalle chiamate dell'API PCD8544, usando l'emulatore
+ * PCD8544Emu al posto del display. Vedi extras/host/README.md per la compilazione.
+ */
+#include <stdio.h>
+#include <chrono>
+#include <PCD8544.h>
+#include <font/mono_5x8px/data.h>
+#include <font/mono_5x8px/meta.h>
+#include <font/prop_5x8px/data.h>
+#include <font/prop_5x8px/meta.h>
+#include <font/digits_10x16px/data.h>
+#include <font/digits_10x16px/meta.h>
+#include <font/digits_10x16px_packed/data.h>
+#include <font/digits_10x16px_packed/meta.h>
+#include <menu/menu.h>
+#include <gfx/Canvas.h>
+#include <gfx/Scene.h>
+#include <gfx/TextField.h>
+#include <gfx/AsyncDisplay.h>
+#include "PCD8544Emu.h"
+
+#define LCD_CS 10
+#define LCD_DC 9
+#define LCD_RST 8
+
+// Etichetta pre-renderizzata in compilazione (font/StaticText.h)
+PCD8544_STATIC_TEXT(SENTENCE_MONO, MONO_5x7, "Temp: 21.5 C ok");
+
+// Menu di examples/DisplayMenu.ino (senza callback)
+static const MenuItem backItem("Indietro");
+static const MenuItem settingsItems[] = {
+    backItem,
+    MenuItem("Contrasto"),
+    MenuItem("Luminosità"),
+    MenuItem("Bias"),
+    MenuItem("TC"),
+};
+static const MenuItem settingsMenu("Impostazioni", nullptr, settingsItems, 5);
+static const MenuItem mainItems[] = { backItem, settingsMenu };
+static const MenuItem rootMenu("Main Menu", nullptr, mainItems, 2);
+
+static void report (const char* what, const pcd8544::PCD8544Emu::Counters& c) {
+    printf("%-34s data=%5u cmd=%4u cs=%4u dc=%4u tr=%3u calls=%5u\n",
+        what,
+        (unsigned)c.dataBytes, (unsigned)c.cmdBytes, (unsigned)c.csCycles,
+        (unsigned)c.dcToggles, (unsigned)c.transactions, (unsigned)c.transferCalls);
+}
+
+int main () {
+    PCD8544 lcd(SPI, {-1, -1, LCD_CS, LCD_DC, LCD_RST, -1});
+    pcd8544::PCD8544Emu emu(SPI, LCD_CS, LCD_DC, LCD_RST);
+
+    report("begin()", emu.measure([&] { lcd.begin(); }));
+    lcd.setFont(MONO_5x7);
+
+    report("clear()", emu.measure([&] { lcd.clear(); }));
+    report("setCursor(0, 0)", emu.measure([&] { lcd.setCursor(0, 0); }));
+    report("print(\"Hello, world!\") 13 ch", emu.measure([&] { lcd.print("Hello, world!"); }));
+    report("print(\"Hello\", highlighted)", emu.measure([&] { lcd.print("Hello", true); }));
+    report("print(F(\"Hello\"))", emu.measure([&] { lcd.print(F("Hello")); }));
+    report("print(12345)", emu.measure([&] { lcd.print(12345); }));
+    report("print(Number(-215, {1, 6}))", emu.measure([&] { lcd.print(pcd8544::Number(-215, {1, 6})); }));
+    report("print(21.5f, 1)", emu.measure([&] { lcd.print(21.5f, 1); }));
+    report("fillRow(5)", emu.measure([&] { lcd.fillRow(5); }));
+    report("drawStraightLine h 0..83 y=10 w=1", emu.measure([&] { lcd.drawStraightLine(0, 83, 10, true, 1); }));
+    report("drawStraightLine v 0..47 x=40 w=2", emu.measure([&] { lcd.drawStraightLine(0, 47, 40, false, 2); }));
+    report("drawStraightLine v 12..35 x=60 w=1", emu.measure([&] { lcd.drawStraightLine(12, 35, 60, false, 1); }));
+    report("bar graph 10 bars 4px full height", emu.measure([&] {
+        for (uint8_t b = 0; b < 10; b++) lcd.drawStraightLine((uint8_t)(b * 4), 47, (uint8_t)(b * 8), false, 4);
+    }));
+    static const uint8_t icon[3 * 4] = {
+        0xFF, 0x81, 0x81, 0xFF,  0x00, 0xFF, 0x00, 0xFF,  0xFF, 0x81, 0x81, 0xFF,
+    };
+    report("drawColumns 3x32 px", emu.measure([&] { lcd.drawColumns(70, 1, 3, 4, icon); }));
+    static uint8_t splash[PAGES * COLUMNS];
+    for (uint16_t i = 0; i < sizeof(splash); i++) splash[i] = (uint8_t)(i * 37);
+    report("drawBitmap 84x48 splash (flash)", emu.measure([&] { lcd.drawBitmap(0, 0, 84, 48, splash, true); }));
+    report("drawBitmap 20x20 at y=13", emu.measure([&] { lcd.drawBitmap(30, 13, 20, 20, splash); }));
+
+    // Stessa riga di testo con il font monospace e con quello variabile
+    static const char sentence[] = "Temp: 21.5 C ok";
+    lcd.setCursor(0, 3);
+    report("print 15 ch, MONO_5x7", emu.measure([&] { lcd.print(sentence); }));
+    lcd.setCursor(0, 3);
+    report("print static 15 ch, MONO_5x7", emu.measure([&] { lcd.print(SENTENCE_MONO); }));
+    // Costo sull'host di una riga ripetuta (emulatore compreso): ricerca dei glyph contro copia dalla flash
+    auto printNs = [&](auto&& text) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (uint16_t r = 0; r < 2000; r++) {
+            lcd.setCursor(0, 3);
+            lcd.print(text);
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / 2000.0;
+    };
+    printf("  host print: string %.0f ns, static %.0f ns, flash %u B\n",
+        printNs(sentence), printNs(SENTENCE_MONO), (unsigned)sizeof(SENTENCE_MONO));
+    lcd.setFont(PROP_5x8);
+    lcd.setCursor(0, 4);
+    report("print 15 ch, PROP_5x8", emu.measure([&] { lcd.print(sentence); }));
+    lcd.setFont(DIGITS_10x16);
+    report("drawText 10x16 \"12:34\" y=16", emu.measure([&] { lcd.drawText(10, 16, "12:34"); }));
+    report("drawText 10x16 \"12:34\" y=27", emu.measure([&] { lcd.drawText(10, 27, "12:34"); }));
+    lcd.setFont(MONO_5x7);
+    lcd.setTextScale(2);
+    report("drawText MONO_5x7 x2 \"12:34\" y=27", emu.measure([&] { lcd.drawText(10, 27, "12:34"); }));
+    lcd.setTextScale(1);
+    lcd.setFont(DIGITS_10x16_PACKED);
+    report("drawText 10x16 packed y=27", emu.measure([&] { lcd.drawText(10, 27, "12:34"); }));
+    lcd.setFont(MONO_5x7);
+    printf("  flash: DIGITS_10x16_PACKED %u B (data %u + index %u + dict %u)\n",
+        (unsigned)(sizeof(DIGITS_10x16_PACKED_DATA) + sizeof(DIGITS_10x16_PACKED_INDEX) + sizeof(DIGITS_10x16_PACKED_DICT)),
+        (unsigned)sizeof(DIGITS_10x16_PACKED_DATA), (unsigned)sizeof(DIGITS_10x16_PACKED_INDEX), (unsigned)sizeof(DIGITS_10x16_PACKED_DICT));
+    // Costo di decodifica sull'host: tutte le colonne di ogni glyph, formato normale e compresso
+    auto decodeNs = [](const pcd8544::FontInfo& f) {
+        pcd8544::ColumnStream cs;
+        volatile uint8_t sink = 0;
+        const uint16_t glyphs = (uint16_t)(f.last - f.first + 1);
+        const auto t0 = std::chrono::steady_clock::now();
+        for (uint16_t r = 0; r < 2000; r++) {
+            for (uint16_t cp = f.first; cp <= f.last; cp++) {
+                cs.begin(f, cp);
+                for (uint16_t k = 0; k < (uint16_t)f.gWidth * f.pages(); k++) sink = (uint8_t)(sink + cs.next());
+            }
+        }
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        return ns / (2000.0 * glyphs);
+    };
+    printf("  host decode: DIGITS_10x16 %.0f ns/glyph, DIGITS_10x16_PACKED %.0f ns/glyph\n",
+        decodeNs(DIGITS_10x16), decodeNs(DIGITS_10x16_PACKED));
+    printf("  flash: DIGITS_10x16_DATA %u B, spread table x2 %u B (x3 %u B, x4 %u B)\n",
+        (unsigned)sizeof(DIGITS_10x16_DATA), (unsigned)sizeof(pcd8544::bits::SPREAD2),
+        (unsigned)sizeof(pcd8544::bits::SPREAD3), (unsigned)sizeof(pcd8544::bits::SPREAD4));
+
+    // Schermata di testo completa: 6 righe x 14 caratteri
+    report("full-screen text 6x14", emu.measure([&] {
+        for (uint8_t row = 0; row < PAGES; row++) {
+            lcd.setCursor(0, row);
+            lcd.print("ABCDEFGHIJKLMN");
+        }
+    }));
+
+    // Schermata di telemetria: 40 chiamate di disegno, senza e con frame
+    auto drawTelemetry = [&](auto& d) {
+        d.drawStraightLine(0, 83, 9, true, 1);
+        d.drawStraightLine(0, 47, 41, false, 1);
+        d.drawStraightLine(0, 83, 47, true, 1);
+        d.fillRow(0);
+        for (uint8_t i = 0; i < 4; i++) {
+            for (uint8_t col = 0; col < 2; col++) {
+                d.setCursor(col ? 44 : 0, (uint8_t)(i + 2));
+                d.print(col ? "B" : "A");
+                d.print((int)(i * 7));
+                d.print("%");
+            }
+        }
+        d.setCursor(0, 1);
+        d.print("T");
+        d.setCursor(44, 1);
+        d.print("OK");
+        d.print(".");
+    };
+    auto telemetry = [&] { drawTelemetry(lcd); };
+    report("telemetry 40 calls", emu.measure(telemetry));
+    report("telemetry 40 calls in frame", emu.measure([&] {
+        PCD8544::FrameScope frame(lcd);
+        telemetry();
+    }));
+
+    // Stessa schermata tramite AsyncDisplay (std::thread al posto del task): le chiamate unite nel frame
+    // diventano meno operazioni in coda, il traffico sul bus resta quello del frame sincrono
+    {
+        static pcd8544::AsyncDisplay<PCD8544> screen(lcd);
+        screen.begin();
+        report("telemetry 40 calls, AsyncDisplay", emu.measure([&] {
+            {
+                pcd8544::AsyncDisplay<PCD8544>::FrameScope frame(screen);
+                drawTelemetry(screen);
+            }
+            screen.flush();
+        }));
+        printf("  queued ops %u (calls merged %u)\n", (unsigned)screen.getStats().ops, (unsigned)screen.getStats().merged);
+        screen.end();
+    }
+
+    // Navigazione del menu di esempio: apertura, ingresso in "Impostazioni", 6 pressioni di "avanti"
+    MenuController menu({20, 21, 22, true, false, 30});
+    menu.attachDisplay(&lcd);
+    menu.createMenu(&rootMenu);
+    #if PCD8544_ENABLE_STATS
+        lcd.resetStats();
+    #endif
+    report("example menu navigation", emu.measure([&] {
+        menu.displayMenu();
+        menu.forward();
+        menu.displayMenu();
+        if (menu.select()) menu.displayMenu();
+        for (uint8_t i = 0; i < 6; i++) {
+            menu.forward();
+            menu.displayMenu();
+        }
+    }));
+    #if PCD8544_ENABLE_STATS
+        printf("  positioning commands elided: %u (commands sent: %u)\n",
+            (unsigned)lcd.getStats().cmdElided, (unsigned)lcd.getStats().cmdSent);
+    #endif
+
+    // Pulsanti: sequenza di fronti simulata (rimbalzi di 3 ms, pressione tenuta 1.5 s) e loop lento
+    {
+        static const char* const names[] = {"PRESS", "RELEASE", "LONG_PRESS", "REPEAT"};
+        pcd8544::ButtonDecoder<1> dec;
+        dec.setRepeat(0, true);
+        dec.setLongPress(0, true);
+        const pcd8544::Edge edges[] = {
+            {100, 0, 1}, {101, 0, 0}, {103, 0, 1}, {104, 0, 0}, {106, 0, 1},     // pressione con rimbalzi
+            {1600, 0, 0}, {1601, 0, 1}, {1603, 0, 0},                           // rilascio con rimbalzi
+            {2000, 0, 1}, {2050, 0, 0},                                         // pressione breve
+        };
+        printf("%-44s", "buttons, bouncy edge stream");
+        uint8_t k = 0;
+        auto print = [&](const pcd8544::ButtonEvent& e) { printf(" %s@%lu", names[(uint8_t)e.type], (unsigned long)e.ms); };
+        // il loop legge la coda ogni 250 ms: gli istanti degli eventi restano quelli dei fronti
+        for (uint32_t now = 0; now <= 2500; now += 250) {
+            while (k < sizeof(edges) / sizeof(edges[0]) && edges[k].ms <= now) dec.feed(edges[k++], print);
+            dec.poll(now, print);
+        }
+        printf("\n");
+    }
+    // Stesso menu pilotato dagli interrupt dei pin: "avanti" tenuto premuto 1 s, update() ogni 10 ms
+    for (uint8_t pin = 20; pin <= 22; pin++) arduino_host::setInputLevel(pin, HIGH);    // a riposo (pull-up)
+    report("menu, forward held 1 s (autorepeat)", emu.measure([&] {
+        menu.update();
+        arduino_host::setInputLevel(21, LOW);
+        delayMicroseconds(2000);
+        arduino_host::setInputLevel(21, HIGH);      // rimbalzo
+        delayMicroseconds(1000);
+        arduino_host::setInputLevel(21, LOW);
+        for (uint8_t i = 0; i < 100; i++) { menu.update(); delay(10); }
+        arduino_host::setInputLevel(21, HIGH);
+        menu.update();
+    }));
+    printf("  cursor %u\n", (unsigned)menu.getCursor());
+
+    // FrameBuffer: primo flush (schermo intero), poi solo le zone cambiate
+    static pcd8544::FrameBuffer fb;
+    fb.setFont(MONO_5x7);
+    auto flushReport = [&](const char* what) {
+        pcd8544::FrameBuffer::FlushStats st;
+        report(what, emu.measure([&] { st = fb.flush(lcd); }));
+        printf("  sent %u/%u data bytes in %u spans\n", (unsigned)st.dataBytes, (unsigned)MAX_BUFFER, (unsigned)st.spans);
+    };
+    fb.drawRect(0, 0, 84, 48);
+    fb.drawText(6, 4, "12:34:56");
+    fb.fillRect(4, 30, 50, 6);
+    flushReport("FrameBuffer flush, first");
+    fb.drawText(42, 4, "57", pcd8544::BlendOp::COPY);
+    flushReport("FrameBuffer flush, seconds");
+    fb.fillRect(54, 30, 4, 6);
+    fb.drawPixel(80, 40);
+    flushReport("FrameBuffer flush, bar + pixel");
+    flushReport("FrameBuffer flush, unchanged");
+
+    // Display list: stessa scena di examples/Scene.ino, poi la barra si sposta di 1 px
+    static pcd8544::Scene<4> scene;
+    scene.setFont(MONO_5x7);
+    scene.addRect(0, 0, 84, 48);
+    scene.addFillRect(8, 12, 68, 20);
+    scene.addText(18, 18, "PCD8544", pcd8544::BlendOp::XOR);
+    const auto bar = scene.addFillRect(10, 4, 6, 40, pcd8544::BlendOp::XOR);
+    uint16_t sceneBytes = 0;
+    report("Scene commit, first", emu.measure([&] { sceneBytes = scene.commit(lcd); }));
+    printf("  sent %u/%u data bytes\n", (unsigned)sceneBytes, (unsigned)MAX_BUFFER);
+    scene.moveTo(bar, 11, 4);
+    report("Scene commit, bar moved 1 px", emu.measure([&] { sceneBytes = scene.commit(lcd); }));
+    printf("  sent %u/%u data bytes\n", (unsigned)sceneBytes, (unsigned)MAX_BUFFER);
+
+    // Contatore a 6 cifre che avanza di 1, 100 volte: print() completo contro TextField
+    report("counter x100, setCursor + print", emu.measure([&] {
+        for (long n = 123456; n < 123556; n++) {
+            lcd.setCursor(30, 5);
+            lcd.print(pcd8544::Number(n, {0, 6}));
+        }
+    }));
+    static pcd8544::TextField<6> counter(30, 5);
+    counter.update(lcd, pcd8544::Number(123455L, {0, 6}));
+    report("counter x100, TextField", emu.measure([&] {
+        for (long n = 123456; n < 123556; n++) counter.update(lcd, pcd8544::Number(n, {0, 6}));
+    }));
+
+    // SegmentTransport con RecordingSink (come PCD8544Dma, senza hardware): transazioni DMA per operazione
+    {
+        static PCD8544Segments<pcd8544::RecordingSink<>> seg({-1, -1, LCD_CS, LCD_DC, LCD_RST, -1}, pcd8544::Pins{-1, -1, LCD_CS, LCD_DC, LCD_RST, -1});
+        seg.begin();
+        seg.setFont(MONO_5x7);
+        auto& sink = seg.transport().sink();
+        auto segments = [&](const char* what, auto&& f) {
+            sink.clear();
+            f();
+            printf("%-44s sends=%3u segments=%3u bytes=%4u\n", what,
+                (unsigned)sink.sends(), (unsigned)sink.segments(), (unsigned)sink.totalBytes());
+        };
+        static pcd8544::FrameBuffer full;
+        full.fillRect(0, 0, 84, 48);
+        segments("segments: FrameBuffer flush, full screen", [&] { full.flush(seg); });
+        segments("segments: clear()", [&] { seg.clear(); });
+        segments("segments: telemetry 40 calls", [&] { drawTelemetry(seg); });
+        segments("segments: telemetry 40 calls in frame", [&] {
+            decltype(seg)::FrameScope frame(seg);
+            drawTelemetry(seg);
+        });
+    }
+
+    // RecordingTransport (nessun bus né emulatore): gli stessi contatori dell'emulatore, registrati dal trasporto
+    {
+        static PCD8544Recording<> rec({-1, -1, LCD_CS, LCD_DC, LCD_RST, -1});
+        rec.begin();
+        rec.setFont(MONO_5x7);
+        auto& tr = rec.transport();
+        auto recorded = [&](const char* what, auto&& f) {
+            tr.clear();
+            f();
+            const auto& c = tr.counters();
+            printf("%-34s data=%5u cmd=%4u cs=%4u dc=%4u tr=%3u writes=%4u\n", what,
+                (unsigned)c.dataBytes, (unsigned)c.cmdBytes, (unsigned)c.csCycles,
+                (unsigned)c.dcToggles, (unsigned)c.transactions, (unsigned)c.writeCalls);
+        };
+        recorded("recording: clear()", [&] { rec.clear(); });
+        rec.setCursor(0, 0);
+        recorded("recording: print(\"Hello, world!\")", [&] { rec.print("Hello, world!"); });
+        recorded("recording: telemetry 40 calls", [&] { drawTelemetry(rec); });
+
+        // Inizializzazione non bloccante con poll() ogni ms (tempo virtuale): tra un poll e l'altro la CPU è libera
+        uint32_t polls = 0;
+        const unsigned long t0 = millis();
+        recorded("recording: beginAsync() + poll()", [&] {
+            rec.beginAsync();
+            while (!rec.poll()) { polls++; delay(1); }
+        });
+        printf("  ready after %lu ms, %u polls\n", millis() - t0, (unsigned)polls);
+        recorded("recording: softRefreshAsync()", [&] {
+            rec.softRefreshAsync();
+            while (!rec.poll()) delay(1);
+        });
+    }
+
+    printf("\n%s", emu.render().c_str());
+    return 0;
+}
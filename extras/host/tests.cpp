@@ -0,0 +1,136 @@
+/*
+ * ** tests (host) **
+ * Verifiche sul contenuto della DDRAM dell'emulatore PCD8544Emu dopo sequenze di chiamate che modificano lo
+ * stato del controller (indirizzamento, power-down, refresh) e per i casi limite dei font.
+ * Ritorna 0 se tutte le verifiche passano.
+ * Vedi extras/host/README.md per la compilazione.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <PCD8544.h>
+#include "PCD8544Emu.h"
+
+#define LCD_CS 10
+#define LCD_DC 9
+#define LCD_RST 8
+
+static PCD8544 lcd(SPI, {-1, -1, LCD_CS, LCD_DC, LCD_RST, -1});
+static pcd8544::PCD8544Emu emu(SPI, LCD_CS, LCD_DC, LCD_RST);
+static uint8_t bmp[3 * 20];
+static int failures = 0;
+
+// Schermo pulito, prep(), poi alcuni bitmap: la DDRAM deve coincidere con reference. Il primo (4x48 px) è
+// scritto con l'indirizzamento verticale, quindi dipende dal bit V effettivo del controller
+template <class F>
+static void check (const char* what, const uint8_t* reference, F&& prep) {
+    lcd.begin();
+    lcd.setAddressing(0);
+    lcd.clear();
+    prep();
+    lcd.drawBitmap(40, 0, 4, 48, bmp);
+    lcd.drawBitmap(10, 8, 20, 24, bmp);
+    lcd.drawBitmap(50, 40, 20, 8, bmp);
+    const bool ok = reference == nullptr || memcmp(emu.ram(), reference, MAX_BUFFER) == 0;
+    printf("%-44s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) {
+        failures++;
+        printf("%s", emu.render().c_str());
+    }
+}
+
+int main () {
+    for (uint16_t i = 0; i < sizeof(bmp); i++) bmp[i] = (uint8_t)(i * 29 + 7);
+
+    static uint8_t reference[MAX_BUFFER];
+    check("reference (horizontal addressing)", nullptr, [] {});
+    memcpy(reference, emu.ram(), MAX_BUFFER);
+
+    check("setAddressing(1)", reference, [] { lcd.setAddressing(1); });
+    check("setAddressing(1), softRefresh()", reference, [] {
+        lcd.setAddressing(1);
+        lcd.softRefresh();
+    });
+    check("setAddressing(1), softRefreshAsync()", reference, [] {
+        lcd.setAddressing(1);
+        lcd.softRefreshAsync();
+        while (!lcd.poll()) delay(1);
+    });
+    check("setAddressing(1), powerDown(), softRefresh()", reference, [] {
+        lcd.setAddressing(1);
+        lcd.powerDown();
+        lcd.softRefresh();
+    });
+    check("setAddressing(1), setContrast()", reference, [] {
+        lcd.setAddressing(1);
+        lcd.setContrast(60);
+    });
+
+    // Blocchi che arrivano all'ultima pagina (indirizzamento verticale, solo Y tra una colonna e l'altra)
+    // e uno che non ci arriva, con entrambe le impostazioni di setAddressing()
+    struct Block { uint8_t x, y, w, h; };
+    const Block blocks[] = { {60, 16, 4, 32}, {76, 8, 2, 40}, {10, 8, 3, 24} };
+    for (uint8_t v = 0; v <= 1; v++) {
+        lcd.begin();
+        lcd.setAddressing(v);
+        lcd.clear();
+        for (const Block& k : blocks) lcd.drawBitmap(k.x, k.y, k.w, k.h, bmp);
+        bool blockOk = true;
+        for (const Block& k : blocks) {
+            for (uint8_t p = 0; p < k.h / 8; p++) {
+                for (uint8_t c = 0; c < k.w; c++) {
+                    if (emu.ram((uint8_t)(k.x + c), (uint8_t)(k.y / 8 + p)) != bmp[p * k.w + c]) blockOk = false;
+                }
+            }
+        }
+        char what[48];
+        snprintf(what, sizeof(what), "drawBitmap() down to the last page, V=%u", (unsigned)v);
+        printf("%-44s %s\n", what, blockOk ? "ok" : "FAIL");
+        if (!blockOk) {
+            failures++;
+            printf("%s", emu.render().c_str());
+        }
+    }
+
+    // Font variabile senza spaziatura con un glyph largo 0 px ('B'): non deve fermare il testo che lo segue
+    static const uint8_t zeroData[] = { 0x11, 0x22, 0x33 };
+    static const uint16_t zeroOffsets[] = { 0, 2, 2, 3 };   // A: 2 colonne, B: 0, C: 1
+    static const pcd8544::FontInfo zeroFont { pcd8544::FONT_FLAG_VARIABLE, 'A', 'C', 8, 0, 0, zeroData, zeroOffsets, nullptr, nullptr, 0 };
+    lcd.begin();
+    lcd.clear();
+    lcd.setFont(zeroFont);
+    lcd.setCursor(0, 1);
+    lcd.print("ABCBA");
+    const uint8_t expected[] = { 0x11, 0x22, 0x33, 0x11, 0x22, 0x00 };
+    const bool zeroOk = memcmp(emu.ram() + COLUMNS, expected, sizeof(expected)) == 0;
+    printf("%-44s %s\n", "print() with a 0 px glyph and no spacing", zeroOk ? "ok" : "FAIL");
+    if (!zeroOk) failures++;
+
+    // Stesso font ingrandito (strisce di pagina): "ABCBA" deve coincidere con "ACA"
+    lcd.clear();
+    lcd.setTextScale(2);
+    lcd.setCursor(0, 0);
+    lcd.print("ABCBA");
+    lcd.setCursor(0, 3);
+    lcd.print("ACA");
+    const bool scaledOk = memcmp(emu.ram(), emu.ram() + 3 * COLUMNS, 2 * COLUMNS) == 0 && emu.ram(0, 0) != 0;
+    printf("%-44s %s\n", "print() scaled with a 0 px glyph", scaledOk ? "ok" : "FAIL");
+    if (!scaledOk) failures++;
+
+    // Dopo softRefresh() senza setCursor() il testo riparte da (0, 0), per i font alti una pagina e per quelli ingranditi
+    for (uint8_t scale = 1; scale <= 2; scale++) {
+        lcd.clear();
+        lcd.setTextScale(scale);
+        lcd.setCursor(40, 2);
+        lcd.softRefresh();
+        lcd.print("A");
+        const bool cursorOk = emu.ram(0, 0) != 0 && emu.ram(40, 2) == 0;
+        char what[48];
+        snprintf(what, sizeof(what), "print() after softRefresh(), scale %u", (unsigned)scale);
+        printf("%-44s %s\n", what, cursorOk ? "ok" : "FAIL");
+        if (!cursorOk) failures++;
+    }
+    lcd.setTextScale(1);
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
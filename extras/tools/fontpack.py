@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""
+Compressore di font e immagini per PCD8544_lib (formato descritto in src/font/README.md).
+
+Legge il primo array di byte di un file .h esistente (es. src/font/mono_5x8px/data.h) e scrive
+data.h / meta.h compressi con lo stesso layout dei font della libreria (nomi prefissati con --name).
+
+    # font: un glyph ogni width * ceil(height / 8) byte
+    python3 extras/tools/fontpack.py font src/font/digits_10x16px/data.h \\
+        --name DIGITS_10x16_PACKED --first 32 --width 10 --height 16 --spacing 2 \\
+        --out src/font/digits_10x16px_packed
+
+    # immagine (formato di drawBitmap: ceil(height / 8) righe da width byte)
+    python3 extras/tools/fontpack.py image logo.h --name LOGO --width 84 --height 48 --out .
+"""
+import argparse
+import collections
+import os
+import re
+
+DICT_SIZE = 13          # codici 0x2 - 0xE
+GROUP = 8               # un ingresso dell'indice ogni 8 glyph
+
+
+def read_bytes(path):
+    text = open(path).read()
+    body = text[text.index('{') + 1:text.index('};')]
+    body = re.sub(r'//.*', '', body)
+    return [int(v, 0) for v in re.findall(r'0[xX][0-9a-fA-F]+|\d+', body)]
+
+
+def build_dict(streams):
+    # colonne non nulle che non ripetono la precedente: sono le uniche che possono usare il dizionario
+    count = collections.Counter()
+    for cols in streams:
+        prev = 0
+        for v in cols:
+            if v != 0 and v != prev:
+                count[v] += 1
+            prev = v
+    return [v for v, _ in count.most_common(DICT_SIZE)]
+
+
+def encode(cols, dictionary):
+    nibbles = []
+    prev = 0
+    for v in cols:
+        if v == 0:
+            nibbles.append(0x0)
+        elif v == prev:
+            nibbles.append(0x1)
+        elif v in dictionary:
+            nibbles.append(0x2 + dictionary.index(v))
+        else:
+            nibbles += [0xF, v >> 4, v & 0x0F]
+        prev = v
+    return nibbles
+
+
+def pack_nibbles(nibbles):
+    if len(nibbles) % 2:
+        nibbles = nibbles + [0]
+    return [(nibbles[i] << 4) | nibbles[i + 1] for i in range(0, len(nibbles), 2)]
+
+
+def c_array(decl, values, fmt='0x%02X', per_line=16):
+    lines = [decl + ' = {']
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ' '.join((fmt % v) + ',' for v in values[i:i + per_line]))
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def write(path, text):
+    with open(path, 'w') as f:
+        f.write(text)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('kind', choices=['font', 'image'])
+    ap.add_argument('source')
+    ap.add_argument('--name', required=True)
+    ap.add_argument('--width', type=int, required=True)
+    ap.add_argument('--height', type=int, default=8)
+    ap.add_argument('--first', type=int, default=32)
+    ap.add_argument('--spacing', type=int, default=1)
+    ap.add_argument('--out', default='.')
+    a = ap.parse_args()
+
+    raw = read_bytes(a.source)
+    pages = (a.height + 7) // 8
+    n = a.name
+    os.makedirs(a.out, exist_ok=True)
+    header = '#pragma once\n#include <stdint.h>\n#include "../FontCompact.h"\n\n'
+
+    if a.kind == 'image':
+        size = a.width * pages
+        cols = raw[:size]
+        dictionary = build_dict([cols])
+        data = pack_nibbles(encode(cols, dictionary))
+        text = header.replace('"../FontCompact.h"', '<font/FontCompact.h>')
+        text += '// %dx%d px, %d byte compressi (%d non compressi), generato da extras/tools/fontpack.py\n' % (
+            a.width, a.height, len(data) + len(dictionary), size)
+        text += 'static constexpr uint8_t %s_WIDTH = %d;\nstatic constexpr uint8_t %s_HEIGHT = %d;\n\n' % (n, a.width, n, a.height)
+        text += c_array('const uint8_t %s_DICT[] FONT_PROGMEM' % n, dictionary + [0] * (DICT_SIZE - len(dictionary))) + '\n\n'
+        text += c_array('const uint8_t %s_DATA[] FONT_PROGMEM' % n, data) + '\n'
+        write(os.path.join(a.out, n.lower() + '.h'), text)
+        print('%s: %d -> %d byte' % (n, size, len(data) + DICT_SIZE))
+        return
+
+    glyph_size = a.width * pages
+    glyphs = [raw[i:i + glyph_size] for i in range(0, len(raw) - glyph_size + 1, glyph_size)]
+    dictionary = build_dict(glyphs)
+    nibbles, index = [], []
+    for i, g in enumerate(glyphs):
+        if i % GROUP == 0:
+            index.append(len(nibbles))
+        nibbles += encode(g, dictionary)
+    assert len(nibbles) < 0x10000, 'font troppo grande per l\'indice a 16 bit'
+    data = pack_nibbles(nibbles)
+    dictionary += [0] * (DICT_SIZE - len(dictionary))
+    last = a.first + len(glyphs) - 1
+    packed = len(data) + 2 * len(index) + DICT_SIZE
+
+    text = header
+    text += '// Compresso da extras/tools/fontpack.py: %d byte (dati %d + indice %d + dizionario %d) invece di %d\n\n' % (
+        packed, len(data), 2 * len(index), DICT_SIZE, len(raw))
+    text += c_array('const uint8_t %s_DATA[] FONT_PROGMEM' % n, data) + '\n\n'
+    text += '// Posizione (in nibble) dei glyph 0, 8, 16, ...\n'
+    text += c_array('const uint16_t %s_INDEX[] FONT_PROGMEM' % n, index, fmt='%d', per_line=12) + '\n\n'
+    text += c_array('const uint8_t %s_DICT[] FONT_PROGMEM' % n, dictionary) + '\n'
+    write(os.path.join(a.out, 'data.h'), text)
+
+    meta = '#pragma once\n#include <stdint.h>\n#include "../FontCompact.h"\n#include "../FontInfo.h"\n\n'
+    meta += 'static constexpr uint8_t %s_FLAGS = 0x12;               // versione 1, compresso\n' % n
+    meta += 'static constexpr uint16_t %s_FIRST_CODEPOINT = %d;\n' % (n, a.first)
+    meta += 'static constexpr uint16_t %s_LAST_CODEPOINT = %d;\n' % (n, last)
+    meta += 'static constexpr uint8_t %s_GLYPH_HEIGHT = %d;\n' % (n, a.height)
+    meta += 'static constexpr uint8_t %s_GLYPH_WIDTH = %d;\n' % (n, a.width)
+    meta += 'static constexpr uint8_t %s_GLYPH_SPACING = %d;\n\n' % (n, a.spacing)
+    meta += 'extern const uint8_t %s_DATA[] FONT_PROGMEM;\n' % n
+    meta += 'extern const uint16_t %s_INDEX[] FONT_PROGMEM;\n' % n
+    meta += 'extern const uint8_t %s_DICT[] FONT_PROGMEM;\n\n' % n
+    meta += 'static constexpr pcd8544::FontInfo %s {\n' % n
+    meta += ''.join('    %s_%s,\n' % (n, f) for f in
+                    ('FLAGS', 'FIRST_CODEPOINT', 'LAST_CODEPOINT', 'GLYPH_HEIGHT', 'GLYPH_WIDTH', 'GLYPH_SPACING', 'DATA', 'INDEX'))
+    meta += '    %s_DICT,\n    nullptr,\n    0\n};\n' % n
+    write(os.path.join(a.out, 'meta.h'), meta)
+    print('%s: %d glyph, %d -> %d byte' % (n, len(glyphs), len(raw), packed))
+
+
+if __name__ == '__main__':
+    main()
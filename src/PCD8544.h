@@ -2,6 +2,13 @@
 #include <Arduino.h>
 #include <SPI.h>
 #include "font/FontInfo.h"
+#include "font/Glyph.h"
+#include "font/Number.h"
+#include "font/StaticText.h"
+#include "io/pins.h"
+#include "io/transport.h"
+#include "io/esp_dma.h"
+#include "io/usart_spi.h"
 
 /*
  * ** PCD8544_lib **
@@ -19,6 +26,26 @@
 #define COLUMNS 84
 #define MAX_BUFFER (PAGES*COLUMNS)
 
+/*
+ * Statistiche del driver (comandi inviati / evitati, ...). Disattivate di default per non occupare RAM:
+ * definire PCD8544_ENABLE_STATS=1 per TUTTE le unità di compilazione (es. build_flags) per attivarle.
+ */
+#ifndef PCD8544_ENABLE_STATS
+#define PCD8544_ENABLE_STATS 0
+#endif
+
+namespace pcd8544 {
+struct Stats {
+    uint32_t cmdSent = 0;       // byte di comando inviati
+    uint32_t cmdElided = 0;     // comandi di posizionamento evitati (contatore X/Y già nella posizione richiesta)
+};
+}
+#if PCD8544_ENABLE_STATS
+#define PCD8544_STAT(field, n) (_stats.field += (n))
+#else
+#define PCD8544_STAT(field, n) ((void)0)
+#endif
+
 // bitmask del Function Set (PCD8544)
 constexpr uint8_t FUNCTION_SET = 0x20;     // base
 constexpr uint8_t FS_PD = 1 << 2;          // Power-down
@@ -40,16 +67,20 @@ enum DISPLAY_CONTROL : uint8_t {
     INVERSE = 0x0D
 };
 
-class PCD8544 {
+/*
+ * PCD8544Base<Transport>: driver completo, parametrizzato sul trasporto (bus SPI e pin CS/DC/RST, vedi
+ * io/transport.h). Normalmente si usano:
+ *  - PCD8544                      SPIClass, pin scelti a runtime (digitalWrite)
+ *  - PCD8544Fast<CS, DC, RST>     SPIClass, pin fissati a compile-time, scrittura diretta dei registri
+ *  - PCD8544Dma (ESP32)           spi_device di ESP-IDF in DMA, CS in hardware e D/C dalla callback
+ *  - PCD8544Usart (ATmega328)     USART0 in modalità Master SPI, il bus SPI resta libero (es. scheda SD)
+ *  - PCD8544Recording<>           nessun bus: i byte vengono registrati in memoria (test e benchmark sul PC)
+ * Il trasporto è un parametro template: le sue funzioni sono inline e non aggiungono chiamate o puntatori.
+ */
+template <class Transport>
+class PCD8544Base {
 public:
-    struct Pins {
-        int8_t sclk;
-        int8_t mosi;
-        int8_t cs;
-        int8_t dc;
-        int8_t rst;
-        int8_t bl;
-    };
+    using Pins = pcd8544::Pins;
 
     struct SettingItem {
         const uint8_t  defaultValue;   // valore registro di default (es. 0xB0)
@@ -100,10 +131,26 @@ public:
     };
 
 
-    PCD8544 (SPIClass& spi, Pins pins, uint32_t spiHz = 2000000, uint8_t spiMode = SPI_MODE0)
-        : _spi(spi), _pins(pins), _spiHz(spiHz), _spiMode(spiMode) {}
+    // pins: RST e retroilluminazione; transportArgs: argomenti del costruttore del trasporto
+    template <class... A>
+    PCD8544Base (Pins pins, A&&... transportArgs) : _pins(pins), _io(static_cast<A&&>(transportArgs)...) {}
 
     void begin (uint16_t blLevel = backlight.defaultValue, uint16_t contrastLevel = contrast.defaultValue,  uint16_t biasLevel = bias.defaultValue, uint16_t tcLevel = tempCoeff.defaultValue);
+    /*
+     *  Inizializzazione non bloccante: beginAsync() configura bus e pin e ritorna subito; le attese del reset e
+     *  dell'accensione (135 ms in tutto) vengono scandite da poll(), da chiamare nel loop finché non
+     *  ritorna true. Nel frattempo il firmware può inizializzare altre periferiche; pendingMs() dice quanti ms
+     *  mancano al passo successivo (es. per dormire). Prima che poll() ritorni true non disegnare.
+     *  begin() esegue la stessa sequenza attendendo con delay().
+     */
+    void beginAsync (uint16_t blLevel = backlight.defaultValue, uint16_t contrastLevel = contrast.defaultValue,  uint16_t biasLevel = bias.defaultValue, uint16_t tcLevel = tempCoeff.defaultValue);
+    bool poll ();
+    inline bool ready () const { return _initStep == INIT_READY; }
+    inline uint32_t pendingMs () const {
+        if (ready()) return 0;
+        const int32_t d = (int32_t)(_stepAt - (uint32_t)millis());
+        return d > 0 ? (uint32_t)d : 0;
+    }
     void setContrast (uint16_t level);
     void setContrastLevels (uint16_t lvls);
     void setBias (uint16_t level);
@@ -125,35 +172,106 @@ public:
     void standby ();
     void displayOn ();
     inline void softRefresh () {
+        _curValid = false;
         transaction([&] {
             write(POWER_DOWN, WRITING_MODE::CMD);
             delay(2);
-            write(BASIC, WRITING_MODE::CMD);
+            sendAddressing();   // esce dal power-down ripristinando l'indirizzamento scelto
             write(DISPLAY_ON, WRITING_MODE::CMD);
         });
     };
+    // Come softRefresh(), ma i 2 ms di power-down vengono attesi da poll() (non disegnare finché non ritorna true)
+    inline void softRefreshAsync () {
+        if (_initStep != INIT_READY && _initStep != INIT_REFRESH) return;   // inizializzazione in corso
+        _curValid = false;
+        transaction([&] { write(POWER_DOWN, WRITING_MODE::CMD); });
+        _vAddr = false;     // POWER_DOWN azzera anche il bit V
+        nextStep(INIT_REFRESH_END, 2);
+    }
     void setFont (const pcd8544::FontInfo& f);
+    inline const pcd8544::FontInfo& getFont () const { return _font; }
+    // Ingrandimento del testo (1..4) per print() e drawText(), solo per font alti al massimo 8 px
+    inline void setTextScale (uint8_t scale) { _textScale = scale < 1 ? 1 : (scale > 4 ? 4 : scale); }
+    inline uint8_t getTextScale () const { return _textScale; }
+    // print() scrive alla posizione del cursore; dopo softRefresh(), softRefreshAsync() o powerDown() la posizione
+    // del controller non è nota e, senza un setCursor(), il testo riparte da (0, 0)
     void print (const char* str, const bool highlighted = false);
     void print (char c, const bool highlighted = false);
-    void print (int value, const bool highlighted = false);
-    void print (unsigned int value, const bool highlighted = false);
+    inline void print (int value, const bool highlighted = false) { print(pcd8544::Number(value), highlighted); }
+    inline void print (unsigned int value, const bool highlighted = false) { print(pcd8544::Number(value), highlighted); }
+    inline void print (long value, const bool highlighted = false) { print(pcd8544::Number(value), highlighted); }
+    inline void print (unsigned long value, const bool highlighted = false) { print(pcd8544::Number(value), highlighted); }
+    // Intero o virgola fissa con larghezza minima, riempimento e segno (vedi font/Number.h)
+    void print (const pcd8544::Number& number, const bool highlighted = false);
     void print (float value, const uint8_t decimals = 2,  const bool highlighted = false);
     void print (const __FlashStringHelper* fstr, const bool highlighted = false);
+    void drawText (int16_t x, int16_t y, const char* str, const bool highlighted = false);
+    template <class Src>
+    void drawRun (int16_t x, int16_t y, Src src, const bool highlighted = false);
+    // Testo pre-renderizzato in compilazione (vedi font/StaticText.h): alla posizione del cursore o in (x, page)
+    template <uint16_t W, uint8_t P>
+    inline void print (const pcd8544::StaticText<W, P>& text, const bool highlighted = false) {
+        printStatic(text.data, W, P, highlighted);
+    }
+    template <uint16_t W, uint8_t P>
+    inline void drawStatic (uint8_t x, uint8_t page, const pcd8544::StaticText<W, P>& text, const bool highlighted = false) {
+        drawStaticText(x, page, text.data, W, P, highlighted);
+    }
     void fillRow (uint8_t row);
+    // Larghezza in pixel di str con il font corrente (spaziatura compresa), anche per i font variabili
+    inline uint16_t textWidth (const char* str) const {
+        return str ? (uint16_t)(pcd8544::textWidth(_font, str, strlen(str)) * textScale()) : 0;
+    }
     inline void printStringCentered (const char* str, const uint8_t notToCenterCoordinate, const bool horizontalAlignment = true, const bool highlighted = false) {
         uint16_t len = strlen(str);
         if (len == 0) return;
-        if (horizontalAlignment && len >= COLUMNS) return print(str, highlighted);
+        const uint16_t width = textWidth(str);
+        if (horizontalAlignment && width >= COLUMNS) return print(str, highlighted);
         uint8_t x, y = 0;
-        if (horizontalAlignment) x = (uint8_t)((uint16_t)(COLUMNS - (uint16_t)(len * (_font.gWidth + _font.gSpacing))) / (uint16_t)2);
+        if (horizontalAlignment) x = (uint8_t)((COLUMNS - width) / 2);
         else y = PAGES / 2 - 1;
         horizontalAlignment ? y = notToCenterCoordinate : x = notToCenterCoordinate;
         
         setCursor(x, y);
         print(str, highlighted);
     }
+    /*
+     *  Frame: raggruppa una sequenza di chiamate di disegno in un'unica transazione SPI con CS sempre basso.
+     *  Le chiamate annidate non aprono né chiudono transazioni. I frame si possono annidare.
+     *  Tra beginFrame() ed endFrame() il bus è occupato dal display: non usare altri dispositivi SPI.
+     */
+    inline void beginFrame () {
+        if (_frameDepth++) return;
+        _io.beginTransaction();
+        _io.csLow();
+    }
+    inline void endFrame () {
+        if (!_frameDepth || --_frameDepth) return;
+        _io.csHigh();
+        _io.endTransaction();
+    }
+    inline bool inFrame () const { return _frameDepth != 0; }
+
+    // Frame con durata di scope: { PCD8544::FrameScope frame(lcd); lcd.print(...); ... }
+    class FrameScope {
+    public:
+        explicit FrameScope (PCD8544Base& d) : _d(d) { _d.beginFrame(); }
+        ~FrameScope () { _d.endFrame(); }
+        FrameScope (const FrameScope&) = delete;
+        FrameScope& operator= (const FrameScope&) = delete;
+    private:
+        PCD8544Base& _d;
+    };
+
     void drawStraightLine (const uint8_t c1, const uint8_t c2, const uint8_t oc, const bool horizontal, const uint8_t borderWidth);
     void drawInRect (const uint8_t x, const uint8_t y, const uint8_t width, const uint8_t height, const uint8_t* buff);
+    void drawBitmap (int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t* bmp, const bool progmem = false);
+    void writeRow (uint8_t page, const uint8_t* buf, uint8_t x = 0, uint8_t len = COLUMNS);
+    void writeRam (uint16_t offset, const uint8_t* buf, uint16_t len);
+    template <class G>
+    void drawGenerated (uint8_t x, uint8_t page, uint8_t width, uint8_t pages, G&& gen);
+    void drawColumns (const uint8_t x, const uint8_t page, const uint8_t width, const uint8_t pages, const uint8_t* data, const bool progmem = false);
+    void drawPacked (const uint8_t x, const uint8_t page, const uint8_t width, const uint8_t pages, const uint8_t* data, const uint8_t* dict);
 
     inline uint16_t getContrast (uint8_t format = 0) {
         return contrast.getCurrentValue(format);
@@ -179,13 +297,20 @@ public:
     inline uint8_t getBrightnessMaxValue (uint8_t format = 0) { return backlight.getMaximum(format); }
     inline uint8_t getTempCoeffMaxValue (uint8_t format = 0) { return tempCoeff.getMaximum(format); }
 
+    // Trasporto in uso (es. lcd.transport().sync() con PCD8544Dma prima dello standby della MCU)
+    inline Transport& transport () { return _io; }
+
+    #if PCD8544_ENABLE_STATS
+        inline const pcd8544::Stats& getStats () const { return _stats; }
+        inline void resetStats () { _stats = pcd8544::Stats(); }
+    #endif
+
 private:
-    SPIClass& _spi;
     Pins _pins;
-    uint32_t _spiHz;
-    uint8_t _spiMode;
-    pcd8544::FontInfo _font {0,0,0,0,0,0,nullptr};
+    Transport _io;
+    pcd8544::FontInfo _font {0,0,0,0,0,0,nullptr,nullptr,nullptr,nullptr,0};
     bool _fontReady = false;
+    uint8_t _textScale = 1;
     static inline SettingItem tempCoeff{0x05, 0x04, 3, 3};
     static inline SettingItem bias {0x14, 0x10, 7, 7};
     static inline SettingItem contrast {0xB0, 0x80, 127, 100};
@@ -194,44 +319,184 @@ private:
     uint8_t _blChannel = 6;
     bool _blInverted = false;
 
+    // Copia del contatore di indirizzo X/Y del controller (shadow cursor). Non valida dopo reset/power-down.
+    uint8_t _curX = 0;
+    uint8_t _curY = 0;
+    bool _curValid = false;
+    bool _vAddr = false;    // indirizzamento verticale attivo (bit V del Function Set)
+    uint8_t _frameDepth = 0;    // livello di annidamento di beginFrame()
+
+    // Passi dell'inizializzazione / refresh non bloccanti (vedi poll()); ogni passo si esegue da _stepAt in poi
+    enum : uint8_t {
+        INIT_READY,
+        INIT_RESET_LOW,     // RST basso
+        INIT_RESET_HIGH,    // RST alto
+        INIT_SETTINGS,      // TC, bias, contrasto, display acceso
+        INIT_CLEAR,         // DDRAM azzerata, retroilluminazione
+        INIT_REFRESH,       // power-down
+        INIT_REFRESH_END    // uscita dal power-down
+    };
+    uint8_t _initStep = INIT_READY;
+    uint32_t _stepAt = 0;
+    uint16_t _initBl = 0;
+    #if PCD8544_ENABLE_STATS
+        pcd8544::Stats _stats;
+    #endif
+
     enum class WRITING_MODE {
         CMD,
         DATA
     };
 
+    // Dentro un frame (beginFrame/endFrame) la transazione è già aperta: f viene eseguita direttamente
     template <class F>
     inline void transaction (F&& f) {
-        _spi.beginTransaction(SPISettings(_spiHz, MSBFIRST, _spiMode));
+        if (_frameDepth) { f(); return; }
+        _io.beginTransaction();
         f();
-        _spi.endTransaction();
+        _io.endTransaction();
     }
 
-    inline void ceHigh () { digitalWrite(_pins.cs, HIGH); }
-    inline void ceLow () { digitalWrite(_pins.cs, LOW); }
-    inline void dcData () { digitalWrite(_pins.dc, HIGH); }
-    inline void dcCmd () { digitalWrite(_pins.dc, LOW); }
-    inline void hwReset () {
-        delay(50);
-        digitalWrite(_pins.rst, LOW);
-        delay(10);
-        digitalWrite(_pins.rst, HIGH);
-        delay(10);
+    // Dentro un frame CS resta basso fino a endFrame()
+    inline void ceHigh () { if (!_frameDepth) _io.csHigh(); }
+    inline void ceLow () { if (!_frameDepth) _io.csLow(); }
+    inline void dcData () { _io.dcData(); }
+    inline void dcCmd () { _io.dcCmd(); }
+    inline void nextStep (uint8_t step, uint32_t waitMs) {
+        _initStep = step;
+        _stepAt = (uint32_t)millis() + waitMs;
     }
     inline void changeSetting (SettingItem& setting, uint16_t level) {
         setting.setFromLevel(level);    // converte 0..levels -> valore registro
+        sendSetting(setting);
+    }
+    inline void sendSetting (const SettingItem& setting) {
         write(EXTENDED, WRITING_MODE::CMD); // Passa in modalità estesa
         write(setting.current, WRITING_MODE::CMD);  // Invia byte corrente del valore in formato registro
-        write(addressing.current, WRITING_MODE::CMD);   // torna al BASIC
+        sendAddressing();   // torna al BASIC
         write(DISPLAY_ON, WRITING_MODE::CMD); // forza refresh
     }
+    // Function Set con il bit V dell'impostazione di indirizzamento, tenendo allineata la copia in _vAddr
+    inline void sendAddressing () {
+        write(addressing.current, WRITING_MODE::CMD);
+        _vAddr = addressing.current & FS_V;
+    }
     inline void setSettingLevels (SettingItem& setting, uint16_t levels) {
         setting.setNumberOfLevels(levels);
     }
     
+    // Invio a blocco senza gestione di CS/DC (vanno impostati dal chiamante)
+    void sendBytes (const uint8_t* buf, size_t len);
+    void sendFill (uint8_t value, size_t n);
+    // Invia len byte generati da gen(i), i = 0..len-1 (il trasporto decide se passare da un buffer di appoggio)
+    template <class G>
+    inline void sendGenerated (size_t len, G&& gen) {
+        advanceCursor(len);
+        _io.writeGenerated(len, gen);
+    }
+
     void write (uint8_t b, WRITING_MODE mode);
     void write (const uint8_t* buf, size_t len);
     void write_P (const uint8_t* src, size_t len, const bool invert = false);
     void writeZeros (uint8_t n, const bool invert);
+    void writeFill (uint8_t value, size_t n);
     void setXY (uint8_t x, uint8_t y);
+    void setVerticalAddressing (bool v);
+    template <class G>
+    void writeBlock (uint8_t x, uint8_t width, uint8_t page, uint8_t pages, G&& gen);
+    // Aggiorna lo shadow cursor dopo n byte dati, seguendo l'auto-incremento del controller (con wrap)
+    inline void advanceCursor (size_t n) {
+        if (!_curValid) return;
+        n %= MAX_BUFFER;
+        if (!_vAddr) {
+            const uint16_t pos = (uint16_t)(((uint16_t)_curY * COLUMNS + _curX + n) % MAX_BUFFER);
+            _curY = (uint8_t)(pos / COLUMNS);
+            _curX = (uint8_t)(pos % COLUMNS);
+        } else {
+            const uint16_t pos = (uint16_t)(((uint16_t)_curX * PAGES + _curY + n) % MAX_BUFFER);
+            _curX = (uint8_t)(pos / PAGES);
+            _curY = (uint8_t)(pos % PAGES);
+        }
+    }
     void drawChar (char c, const bool inverted = false);
-};
\ No newline at end of file
+    // Src: sorgente di codepoint con more() e next() (pcd8544::Utf8Source, pcd8544::Number)
+    template <class Src>
+    void writeTextRun (Src src, const bool inverted);
+    template <class Src>
+    void writeTextStrips (int16_t x, int16_t y, Src src, const bool inverted);
+    template <class Src>
+    void printText (Src src, const bool inverted);
+    void printStatic (const uint8_t* data, uint16_t width, uint8_t pages, const bool inverted);
+    void drawStaticText (uint8_t x, uint8_t page, const uint8_t* data, uint16_t width, uint8_t pages, const bool inverted);
+    // Fattore di scala effettivo: i font alti più di una pagina non vengono ingranditi
+    inline uint8_t textScale () const { return _font.pages() == 1 ? _textScale : 1; }
+};
+
+#include "PCD8544_impl.h"
+
+/*
+ *  PCD8544: display con pin CS/DC/RST scelti a runtime.
+ */
+class PCD8544 : public PCD8544Base<pcd8544::SpiTransport<pcd8544::RuntimePins>> {
+public:
+    PCD8544 (SPIClass& spi, Pins pins, uint32_t spiHz = 2000000, uint8_t spiMode = SPI_MODE0)
+        : PCD8544Base(pins, spi, pins, spiHz, spiMode) {}
+};
+extern template class PCD8544Base<pcd8544::SpiTransport<pcd8544::RuntimePins>>;
+
+/*
+ *  PCD8544Fast: display con pin CS/DC/RST fissati a compile-time. CS e DC vengono commutati scrivendo
+ *  direttamente i registri di porta (vedi io/pins.h) invece di usare digitalWrite.
+ *  Es.: PCD8544Fast<10, 9, 8> lcd(SPI, SCK, MOSI, LCD_BL, 4000000);
+ */
+template <uint8_t CS, uint8_t DC, uint8_t RST>
+class PCD8544Fast : public PCD8544Base<pcd8544::SpiTransport<pcd8544::FastPins<CS, DC, RST>>> {
+public:
+    PCD8544Fast (SPIClass& spi, int8_t sclk = -1, int8_t mosi = -1, int8_t bl = -1, uint32_t spiHz = 2000000, uint8_t spiMode = SPI_MODE0)
+        : PCD8544Fast(spi, pcd8544::Pins{sclk, mosi, (int8_t)CS, (int8_t)DC, (int8_t)RST, bl}, spiHz, spiMode) {}
+private:
+    PCD8544Fast (SPIClass& spi, const pcd8544::Pins& pins, uint32_t spiHz, uint8_t spiMode)
+        : PCD8544Base<pcd8544::SpiTransport<pcd8544::FastPins<CS, DC, RST>>>(pins, spi, pins, spiHz, spiMode) {}
+};
+
+/*
+ *  PCD8544Segments<Sink>: display su SegmentTransport (vedi io/transport.h). I byte vengono raggruppati in
+ *  segmenti comando/dati e consegnati al Sink, es. RecordingSink per verificarli sul PC.
+ */
+template <class Sink>
+using PCD8544Segments = PCD8544Base<pcd8544::SegmentTransport<Sink>>;
+
+/*
+ *  PCD8544Recording<BYTES>: display su RecordingTransport (vedi io/transport.h), senza bus né pin: i byte
+ *  e gli eventi di CS/DC vengono registrati in memoria, per i test e i benchmark sul PC.
+ */
+template <uint16_t BYTES = 1024>
+using PCD8544Recording = PCD8544Base<pcd8544::RecordingTransport<BYTES>>;
+
+#if defined(PCD8544_HAS_USART_SPI)
+/*
+ *  PCD8544Usart: display sulla USART0 in modalità Master SPI (ATmega328, vedi io/usart_spi.h). SCLK sul
+ *  pin 4 e MOSI sul pin 1, il bus SPI resta libero per altre periferiche (es. scheda SD).
+ *  Es.: PCD8544Usart lcd({-1, -1, LCD_CS, LCD_DC, LCD_RST, LCD_BL}, 4000000);
+ *  Con pin fissati a compile-time: PCD8544Base<pcd8544::UsartSpiTransport<pcd8544::FastPins<CS, DC, RST>>>
+ */
+class PCD8544Usart : public PCD8544Base<pcd8544::UsartSpiTransport<pcd8544::RuntimePins>> {
+public:
+    PCD8544Usart (Pins pins, uint32_t hz = 4000000, uint8_t mode = SPI_MODE0)
+        : PCD8544Base(pins, pins, hz, mode) {}
+};
+#endif
+
+#if defined(ARDUINO_ARCH_ESP32)
+/*
+ *  PCD8544Dma: display su un bus SPI di ESP-IDF (di default SPI2_HOST) con trasferimenti DMA. Ogni gruppo
+ *  di comandi o di dati è una transazione; un frame completo sono poche transazioni, trasmesse mentre il
+ *  driver prepara le successive. I pin SCLK, MOSI, CS e DC sono obbligatori.
+ *  Es.: PCD8544Dma lcd({LCD_SCK, LCD_MOSI, LCD_CS, LCD_DC, LCD_RST, LCD_BL}, 4000000);
+ */
+class PCD8544Dma : public PCD8544Base<pcd8544::SegmentTransport<pcd8544::EspDmaSink<>>> {
+public:
+    PCD8544Dma (Pins pins, uint32_t spiHz = 4000000, spi_host_device_t host = SPI2_HOST)
+        : PCD8544Base(pins, pins, pins, spiHz, host) {}
+};
+#endif
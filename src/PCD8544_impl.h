@@ -0,0 +1,1056 @@
+#pragma once
+/*
+ * Implementazione di PCD8544Base<Transport>. Incluso da PCD8544.h: essendo un template, il codice deve
+ * essere visibile in ogni unità di compilazione che lo istanzia (es. PCD8544Fast<...>).
+ * La variante a pin runtime (PCD8544) è istanziata una sola volta in PCD8544.cpp.
+ */
+#include "font/FontCompact.h"
+#include "font/ColumnStream.h"
+#include "gfx/bits.h"
+
+/*
+ *  Function: begin   
+ *  Desc: Inizializza SPI e il display con reset e impostazioni base (bloccante, vedi beginAsync)
+ */
+template <class Transport>
+void PCD8544Base<Transport>::begin (uint16_t blLevel /*0..100*/,
+    uint16_t contrastLevel /*0..100*/,
+    uint16_t biasLevel /*0..7*/,
+    uint16_t tcLevel /*0..3*/
+    ) {
+    beginAsync(blLevel, contrastLevel, biasLevel, tcLevel);
+    while (!poll()) delay(pendingMs());
+}
+
+/*
+ *  Function: beginAsync   
+ *  Desc: Configura bus e pin e avvia l'inizializzazione del display, completata dalle chiamate a poll()
+ */
+template <class Transport>
+void PCD8544Base<Transport>::beginAsync (uint16_t blLevel /*0..100*/,
+    uint16_t contrastLevel /*0..100*/,
+    uint16_t biasLevel /*0..7*/,
+    uint16_t tcLevel /*0..3*/
+    ) {
+    _io.begin();    // bus e pin CS, DC, RST (CS alto)
+    if (_pins.bl >= 0) pinMode(_pins.bl, OUTPUT);
+    backlightLevel(0);
+
+    // i livelli vengono convertiti subito, i registri inviati al passo INIT_SETTINGS
+    tempCoeff.setFromLevel(tcLevel);
+    bias.setFromLevel(biasLevel);
+    contrast.setFromLevel(contrastLevel);
+    _initBl = blLevel;
+    _curValid = false;
+    nextStep(INIT_RESET_LOW, 100);  // alimentazione stabile prima del reset
+}
+
+/*
+ *  Function: poll   
+ *  Desc: Esegue i passi di inizializzazione / refresh la cui attesa è scaduta; ritorna true a display pronto
+ */
+template <class Transport>
+bool PCD8544Base<Transport>::poll () {
+    while (_initStep != INIT_READY && (int32_t)((uint32_t)millis() - _stepAt) >= 0) {
+        switch (_initStep) {
+        case INIT_RESET_LOW:
+            _io.rstLow();
+            nextStep(INIT_RESET_HIGH, 10);
+            break;
+        case INIT_RESET_HIGH:
+            _io.rstHigh();
+            addressing.setFromLevel(0);
+            _vAddr = false;
+            nextStep(INIT_SETTINGS, 20);
+            break;
+        case INIT_SETTINGS:
+            transaction([&] {
+                sendSetting(tempCoeff);
+                sendSetting(bias);
+                sendSetting(contrast);
+                write(DISPLAY_ON, WRITING_MODE::CMD);
+            });
+            nextStep(INIT_CLEAR, 2);
+            break;
+        case INIT_CLEAR:
+            clear();
+            #if defined(ARDUINO_ARCH_ESP32)
+                if (_pins.bl >= 0) {
+                    ledcSetup(_blChannel, 20000, 8);
+                    ledcAttachPin(_pins.bl, _blChannel);
+                }
+            #endif
+            backlightLevel(_initBl);
+            nextStep(INIT_REFRESH, 1);
+            break;
+        case INIT_REFRESH:
+            softRefreshAsync();     // -> INIT_REFRESH_END fra 2 ms
+            break;
+        case INIT_REFRESH_END:
+        default:
+            transaction([&] {
+                sendAddressing();
+                write(DISPLAY_ON, WRITING_MODE::CMD);
+            });
+            _initStep = INIT_READY;
+            break;
+        }
+    }
+    return _initStep == INIT_READY;
+}
+
+/*
+ *  Function: write   
+ *  Desc: Trasferisce un byte in SPI a seconda della modalità scelta (command o data)
+ */
+template <class Transport>
+void PCD8544Base<Transport>::write (uint8_t b, WRITING_MODE mode) {
+    switch (mode) {
+    case WRITING_MODE::CMD:
+        dcCmd();
+        break;
+    case WRITING_MODE::DATA:
+    default:
+        dcData();
+        break;
+    }
+    ceLow();
+    _io.write(b);
+    ceHigh();
+    if (mode == WRITING_MODE::DATA) advanceCursor(1);
+    else PCD8544_STAT(cmdSent, 1);
+}
+/*
+ *  Function: write   
+ *  Desc: Trasferisce un buffer di lunghezza specificata in SPI in modalità DATA
+ */
+template <class Transport>
+void PCD8544Base<Transport>::write (const uint8_t* buf, size_t len) {
+    dcData(); ceLow();
+    sendBytes(buf, len);
+    ceHigh();
+}
+/*
+ *  Function: write_P   
+ *  Desc: Trasferisce un buffer di lunghezza specificata in SPI in modalità DATA da sorgente in flash/PROGMEM (no RAM)
+ */
+template <class Transport>
+void PCD8544Base<Transport>::write_P (const uint8_t* src, size_t len, const bool invert) {
+    const uint8_t mask = invert ? 0xFF : 0x00;
+    dcData(); ceLow();
+    sendGenerated(len, [&](size_t i) { return (uint8_t)(FONT_READ_U8(src + i) ^ mask); });
+    ceHigh();
+}
+/*
+ *  Function: writeZeros   
+ *  Desc: Trasferisce in SPI in modalità DATA n 0x00.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::writeZeros (uint8_t n, const bool invert) {
+    writeFill(invert ? 0xFF : 0x00, n);
+}
+/*
+ *  Function: writeFill   
+ *  Desc: Trasferisce in SPI in modalità DATA n byte uguali a value.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::writeFill (uint8_t value, size_t n) {
+    if (!n) return;
+    dcData(); ceLow();
+    sendFill(value, n);
+    ceHigh();
+}
+
+/*
+ *  Function: sendBytes   
+ *  Desc: Invia un buffer in RAM a blocchi. Non gestisce CS e DC.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::sendBytes (const uint8_t* buf, size_t len) {
+    advanceCursor(len);
+    _io.write(buf, len);
+}
+/*
+ *  Function: sendFill   
+ *  Desc: Invia n byte uguali a value, a blocchi. Non gestisce CS e DC.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::sendFill (uint8_t value, size_t n) {
+    sendGenerated(n, [&](size_t) { return value; });
+}
+
+/*
+ *  Function: setContrast   
+ *  Desc: Imposta il contrasto ed aggiorna il valore corrente
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setContrast (uint16_t level) {
+    transaction([&] {
+        changeSetting(contrast, level);
+    });
+}
+/*
+ *  Function: setContrastLevels   
+ *  Desc: Imposta il numero di livelli per l'impostazione di contrasto
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setContrastLevels (uint16_t lvls) {
+    setSettingLevels(contrast, lvls);
+}
+/*
+ *  Function: setBias   
+ *  Desc: Imposta il bias ed aggiorna il valore corrente
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setBias (uint16_t level) {
+    transaction([&] {
+        changeSetting(bias, level);
+    });
+}
+/*
+ *  Function: setBiasLevels   
+ *  Desc: Imposta il numero di livelli per l'impostazione di bias
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setBiasLevels (uint16_t lvls) {
+    setSettingLevels(bias, lvls);
+}
+/*
+ *  Function: setTC   
+ *  Desc: Imposta il coefficiente di temperatura ed aggiorna il valore corrente
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setTC (uint16_t level) {
+    transaction([&] {
+        changeSetting(tempCoeff, level);
+    });
+}
+/*
+ *  Function: setTCLevels   
+ *  Desc: Imposta il numero di livelli per l'impostazione di coefficiente di temperatura
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setTCLevels (uint16_t lvls) {
+    setSettingLevels(tempCoeff, lvls);
+}
+/*
+ *  Function: setAddressing   
+ *  Desc: Imposta il verso di indirizzamento del cursore, orizzontale (0) o verticale (1)
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setAddressing(uint8_t level) {
+    addressing.setFromLevel(level);                 // 0..1
+    sendAddressing();                               // invia 0x20 o 0x22
+}
+
+
+/*
+ *  Function: backlightLevel   
+ *  Desc: Imposta l'intensità di luce tramite il livello di pwm passato alla funzione (0% - 100%).
+ *  Per poter utilizzare questa funzione è necessario aver impostato il pin relativo alla backlight
+ *  nella dichiarazione dell'istanza della classe PCD8544.
+ *  
+ *  N.B. Il minimo ed il massimo della luminosità dipendono da come è stato configurato l'hardware.
+ *    - Se si usa il pin pwm per alimentare la backlight del display allora il funzionamento sarà active HIGH
+ *    - Se si usa il pin per comandare un transistor NPN che controlla la luminosità, il funzionamento sarà actvie LOW.
+ *    - Se si usa il pin per comandare un transistor PNP che controllà la luminostità il funzionamento sarà active HIGH.
+ *  
+ *    Qualora il funzionamento sarà active LOW, allora 0 corrisponderà alla luminostià massima; per evitare
+ *    ciò, e mantenere il classico e più intuitivo livello di luminosità in cui la luminosità minima corrisponde
+ *    al livello 0 e la luminosità massima al livello 100% (255), allora bisognerà usare la funzione invertedBacklightLevel
+ *    per invertire i livelli di luminosità.
+ *
+ *  Si consiglia di utilizzare una resistenza da circa 470 ohm in serie al pin relativo all'illuminazione del modulo.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::backlightLevel (uint16_t level) {
+    if (_pins.bl < 0) return;
+    backlight.setFromLevel(level);  // salva livello e calcola current = min + x
+    uint8_t pwm = backlight.current; // qui current lo usiamo come PWM 0..255
+    if (_blInverted) pwm = 255 - pwm;
+    #if defined(ARDUINO_ARCH_ESP32)
+        ledcWrite(_blChannel, pwm);
+    #else
+        analogWrite(_pins.bl, pwm);
+    #endif
+}
+/*
+ *  Function: setBacklightLevels   
+ *  Desc: Imposta il numero di livelli per l'impostazione di backlight
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setBacklightLevels (uint16_t lvls) {
+    setSettingLevels(backlight, lvls);
+}
+
+/*
+ *  Function: invertedBacklightLevel   
+ *  Desc: (SOLO ESP32) Configura il canale pwm per la backlight. Di default è usato il canale 6. È possibile
+ *  cambiare il canale con questa funzioni. Ed è possibile anche modificare la frequenza e la risoluzione, ma
+ *  si sconsiglia di toccare queste impostazioni poichè i livelli di backlight della libreria sono 255 e non 1023
+ *  o altri valori. La possibilità di modificare questi altri due valori è stata lasciata per utenti esperti.
+ */
+#if defined(ARDUINO_ARCH_ESP32)
+template <class Transport>
+void PCD8544Base<Transport>::configureBacklightPWM (uint8_t channel, uint32_t freq, uint8_t resolutionBits) {
+    _blChannel = channel;
+    ledcSetup(_blChannel, freq, resolutionBits);
+    ledcAttachPin(_pins.bl, _blChannel);
+}
+#endif
+
+/*
+ *  Function: invertedBacklightLevel   
+ *  Desc: Imposta se i livelli di intensità di backlight del modulo display devono essere invertiti o meno:
+ *  - false = 0 (min) - 255 (max)
+ *  - true = 0 (max) - 255 (min)
+ */
+template <class Transport>
+void PCD8544Base<Transport>::invertedBacklightLevel (bool inv) {
+    _blInverted = inv;
+}
+
+/*
+ *  Function: setXY   
+ *  Desc: Imposta il cursore. Invia solo gli assi che cambiano rispetto alla posizione in cui
+ *      l'auto-incremento del controller ha lasciato il contatore di indirizzo (shadow cursor).
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setXY (uint8_t x, uint8_t y) {
+    if (x > 83) x = 83;
+    if (y > 5) y = 5;
+    if (!_curValid || _curY != y) write((0x40 | y), WRITING_MODE::CMD);
+    else PCD8544_STAT(cmdElided, 1);
+    if (!_curValid || _curX != x) write((0x80 | x), WRITING_MODE::CMD);
+    else PCD8544_STAT(cmdElided, 1);
+    _curX = x;
+    _curY = y;
+    _curValid = true;
+}
+
+/*
+ *  Function: setVerticalAddressing   
+ *  Desc: Passa temporaneamente all'indirizzamento verticale (true) o orizzontale (false), senza modificare
+ *      l'impostazione scelta con setAddressing(). Non invia nulla se il controller è già nel modo richiesto.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setVerticalAddressing (bool v) {
+    if (_vAddr == v) return;
+    write(v ? BASIC_VERTICAL_ADDRESSING : BASIC_HORIZONTAL_ADDRESSING, WRITING_MODE::CMD);
+    _vAddr = v;
+}
+
+/*
+ *  Function: writeBlock   
+ *  Desc: Scrive un blocco di width colonne x pages pagine a partire da (x, page). Ogni byte è generato da
+ *      gen(colonna, pagina), con colonna e pagina relative al blocco. Sceglie l'indirizzamento che richiede
+ *      meno comandi:
+ *      - orizzontale: un burst di width byte per pagina (2 comandi di posizionamento per pagina)
+ *      - verticale: un burst di pages byte per colonna (2 comandi per colonna, 1 se il blocco arriva
+ *        all'ultima pagina), oppure un unico burst se il blocco occupa tutte le pagine (il contatore passa
+ *        da solo alla colonna successiva)
+ *      Il passaggio all'indirizzamento verticale costa 2 comandi (andata e ritorno); alla fine viene
+ *      ripristinato il modo impostato con setAddressing(). Va chiamata dentro transaction().
+ */
+template <class Transport>
+template <class G>
+void PCD8544Base<Transport>::writeBlock (uint8_t x, uint8_t width, uint8_t page, uint8_t pages, G&& gen) {
+    if (!width || !pages) return;
+    const bool userV = addressing.current & FS_V;
+    const bool fullHeight = (page == 0 && pages == PAGES);
+    // Blocco che arriva all'ultima pagina: dopo ogni colonna il contatore torna a Y = 0 sulla colonna
+    // successiva, quindi setXY() invia solo Y (X coincide con il cursore ombra)
+    const bool toBottom = (uint8_t)(page + pages) == PAGES;
+    const uint16_t costH = (uint16_t)2 * pages + (userV ? 2 : 0);
+    const uint16_t costV = (uint16_t)(fullHeight ? 2 : toBottom ? width + 1 : 2 * width) + (userV ? 0 : 2);
+
+    if (costV < costH) {
+        setVerticalAddressing(true);
+        if (fullHeight) {
+            uint8_t c = 0, p = 0;
+            setXY(x, 0);
+            dcData(); ceLow();
+            sendGenerated((size_t)width * PAGES, [&](size_t) {
+                const uint8_t b = gen(c, p);
+                if (++p == PAGES) { p = 0; c++; }
+                return b;
+            });
+            ceHigh();
+        } else {
+            for (uint8_t c = 0; c < width; c++) {
+                uint8_t p = 0;
+                setXY((uint8_t)(x + c), page);
+                dcData(); ceLow();
+                sendGenerated(pages, [&](size_t) { return gen(c, p++); });
+                ceHigh();
+            }
+        }
+    } else {
+        setVerticalAddressing(false);
+        for (uint8_t p = 0; p < pages; p++) {
+            uint8_t c = 0;
+            setXY(x, (uint8_t)(page + p));
+            dcData(); ceLow();
+            sendGenerated(width, [&](size_t) { return gen(c++, p); });
+            ceHigh();
+        }
+    }
+    setVerticalAddressing(userV);
+}
+
+/*
+ *  Function: setCursor   
+ *  Desc: Imposta il cursore. Se coincide con il cursore ombra non apre nemmeno la transazione.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setCursor (uint8_t x, uint8_t y) {
+    if (x > 83) x = 83;
+    if (y > 5) y = 5;
+    if (_curValid && _curX == x && _curY == y) {
+        PCD8544_STAT(cmdElided, 2);
+        return;
+    }
+    transaction([&] {
+        setXY(x, y);
+    });
+}
+
+
+/*
+ *  Function: clear   
+ *  Desc: Pulisce il display (imposta tutti i byte a 0)
+ */
+template <class Transport>
+void PCD8544Base<Transport>::clear () {
+    transaction([&] {
+        for (uint8_t page = 0; page < PAGES; page++) {
+            setXY(0, page);
+            writeFill(0x00, COLUMNS);   // 84 byte consecutivi
+        }
+    });
+    setCursor(0, 0);
+}
+
+/*
+ *  Function: powerDown   
+ *  Desc: Spegne il display e resetta la RAM del driver.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::powerDown () {
+    _curValid = false;
+    transaction([&] {
+        write(POWER_DOWN, WRITING_MODE::CMD);
+    });
+    _vAddr = false;     // POWER_DOWN azzera anche il bit V
+}
+
+/*
+ *  Function: standby   
+ *  Desc: Mette in standby il display (blank), lo schermo diventa vuoto, ma non viene cancellato
+ *        il buffer in RAM del driver.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::standby () {
+    transaction([&] {
+        write(BLANK, WRITING_MODE::CMD);
+    });
+}
+
+/*
+ *  Function: standby   
+ *  Desc: Accende il display
+ */
+template <class Transport>
+void PCD8544Base<Transport>::displayOn () {
+    transaction([&] {
+        write(DISPLAY_ON, WRITING_MODE::CMD);
+    });
+}
+
+/*
+ *  Function: setFont   
+ *  Desc: Imposta il font da usare. I font a larghezza variabile (GLYPH_WIDTH = 0) richiedono la tabella
+ *      degli offset (vedi font/README.md).
+ */
+template <class Transport>
+void PCD8544Base<Transport>::setFont (const pcd8544::FontInfo& f) {
+    if (!f.isValid()) return;
+
+    _font = f;
+    _fontReady = true;
+}
+
+/*
+ *  Function: drawChar   
+ *  Desc: Prende in input un carattere e lo trasferisce in SPI al driver seguendo lo schema di caratteri
+ *      definito dal font in uso.
+ *      N.B.
+ *      È necessario che sia presente la cartella "/font" con i relativi file generali e che sia presente la
+ *      cartella del font da usare, e che il font sia stato correttamente settato tramite il metodo setFont.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::drawChar (char c, const bool inverted) {
+    if (!_fontReady) return;
+    writeTextRun(pcd8544::Utf8Source{&c, &c + 1, false}, inverted);
+}
+
+/*
+ *  Function: writeTextRun   
+ *  Desc: Invia i caratteri di una sorgente di codepoint (stringa UTF-8 in RAM o in flash, numero formattato)
+ *      come un'unica sequenza di colonne (glyph + spaziatura), con un solo ciclo di CS e una sola impostazione
+ *      di D/C. Le colonne vengono generate al volo e inviate a blocchi tramite il buffer di appoggio.
+ *      Non apre la transazione SPI: va chiamata dentro transaction().
+ */
+template <class Transport>
+template <class Src>
+void PCD8544Base<Transport>::writeTextRun (Src src, const bool inverted) {
+    if (!src.more()) return;
+    const uint8_t mask = inverted ? 0xFF : 0x00;
+    pcd8544::ColumnStream glyph;    // colonne del carattere corrente (anche da font compresso)
+    uint8_t adv = 0;
+    // i glyph larghi 0 px senza spaziatura non occupano colonne (e con adv = 0 la cella non finirebbe mai)
+    auto beginGlyph = [&] {
+        do {
+            glyph.begin(_font, src.next());
+            adv = (uint8_t)(glyph.width() + _font.gSpacing);
+        } while (!adv && src.more());
+    };
+
+    // con i font variabili la lunghezza del burst richiede una prima passata sulle larghezze
+    const uint16_t total = pcd8544::runWidth(_font, src);
+    uint8_t col = 0;    // colonna corrente all'interno della cella del carattere
+    beginGlyph();
+
+    dcData(); ceLow();
+    sendGenerated(total, [&](size_t) {
+        uint8_t b = (col < glyph.width()) ? glyph.next() : 0x00;
+        if (++col == adv) {
+            col = 0;
+            if (src.more()) beginGlyph();
+        }
+        return (uint8_t)(b ^ mask);
+    });
+    ceHigh();
+}
+
+
+/*
+ *  Function: print   
+ *  Desc: Prende in input una stringa e la stampa sul display. È possibile scegliere se evidenziare la stringa o meno.
+ *      N.B.
+ *      È necessario che sia presente la cartella "/font" con i relativi file generali e che sia presente la
+ *      cartella del font da usare, e che il font sia stato correttamente settato tramite il metodo setFont.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::print (const char* str, const bool highlighted) {
+    if (!str || !_fontReady) return;
+    printText(pcd8544::Utf8Source{str, str + strlen(str), false}, highlighted);
+}
+template <class Transport>
+void PCD8544Base<Transport>::print (char c, const bool highlighted) {
+    char str[2] = {c, '\0'};
+    print(str, highlighted);
+}
+
+/*
+ *  Function: print   
+ *  Desc: Stampa un numero formattato (vedi font/Number.h): le cifre vengono prodotte dalla più significativa
+ *      e inviate subito come colonne, senza stringa intermedia.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::print (const pcd8544::Number& number, const bool highlighted) {
+    if (!_fontReady) return;
+    printText(number, highlighted);
+}
+
+/*
+ *  Function: print   
+ *  Desc: Stampa un float con decimals cifre decimali (al massimo 9). Il valore viene convertito una sola volta
+ *      in virgola fissa (intero a 32 bit in unità di 10^-decimals, arrotondato) e stampato come un intero;
+ *      se non rientra nei 32 bit le cifre decimali vengono ridotte. NaN e valori troppo grandi stampano "nan"
+ *      e "ovf".
+ */
+template <class Transport>
+void PCD8544Base<Transport>::print (float value, const uint8_t decimals,  const bool highlighted) {
+    if (value != value) return print("nan", highlighted);
+    uint8_t d = decimals > pcd8544::Number::MAX_DECIMALS ? pcd8544::Number::MAX_DECIMALS : decimals;
+    float scaled = value * (float)FONT_READ_U32(pcd8544::POW10 + d);
+    while (d && (scaled >= 2147483647.0f || scaled <= -2147483647.0f)) {
+        d--;
+        scaled = value * (float)FONT_READ_U32(pcd8544::POW10 + d);
+    }
+    if (scaled >= 2147483647.0f || scaled <= -2147483647.0f) return print("ovf", highlighted);
+    const long fixed = (long)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+    print(pcd8544::Number(fixed, {d}), highlighted);
+}
+
+
+template <class Transport>
+void PCD8544Base<Transport>::print(const __FlashStringHelper* fstr, bool highlighted) {
+    if (!fstr || !_fontReady) return;
+    const char* p = reinterpret_cast<const char*>(fstr);
+#if defined(ARDUINO_ARCH_AVR)
+    const size_t len = strlen_P(p);
+#else
+    // Su ESP32 (e molte altre), la flash è memory-mapped: puoi leggerla come un C-string normale
+    const size_t len = strlen(p);
+#endif
+    printText(pcd8544::Utf8Source{p, p + len, true}, highlighted);
+}
+
+/*
+ *  Function: printText   
+ *  Desc: Stampa i caratteri di una sorgente di codepoint alla posizione del cursore (in (0, 0) se non è noto, es.
+ *      dopo softRefresh() o powerDown() senza setCursor()). I font alti una pagina usano
+ *      un unico burst (writeTextRun); quelli più alti vengono disegnati per strisce di pagina a partire dalla riga del
+ *      cursore (writeTextStrips, anche per il testo ingrandito), dopodiché il cursore viene portato a destra del testo, sulla stessa riga.
+ */
+template <class Transport>
+template <class Src>
+void PCD8544Base<Transport>::printText (Src src, const bool inverted) {
+    transaction([&] {
+        if (!_curValid) setXY(0, 0);    // contatore non noto (dopo refresh / power-down): si riparte da (0, 0)
+        if (_font.pages() == 1 && textScale() == 1) return writeTextRun(src, inverted);
+        const uint8_t x = _curX;
+        const uint8_t page = _curY;
+        writeTextStrips(x, (int16_t)(page * 8), src, inverted);
+        const uint16_t next = (uint16_t)(x + pcd8544::runWidth(_font, src) * textScale());
+        if (next < COLUMNS) setXY((uint8_t)next, page);
+    });
+}
+
+/*
+ *  Function: printStatic   
+ *  Desc: Stampa alla posizione del cursore un testo pre-renderizzato (width colonne x pages pagine, in flash,
+ *      memorizzato per colonne). Alta una pagina, il testo è un unico burst che prosegue sulla riga successiva
+ *      come print(); più alto, viene disegnato a partire dalla riga del cursore, che viene poi portato a destra
+ *      del testo.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::printStatic (const uint8_t* data, uint16_t width, uint8_t pages, const bool inverted) {
+    transaction([&] {
+        if (!_curValid) setXY(0, 0);
+        if (pages == 1) return write_P(data, width, inverted);
+        const uint8_t x = _curX;
+        const uint8_t page = _curY;
+        drawStaticText(x, page, data, width, pages, inverted);
+        if (x + width < COLUMNS) setXY((uint8_t)(x + width), page);
+    });
+}
+
+/*
+ *  Function: drawStaticText   
+ *  Desc: Disegna un testo pre-renderizzato con l'angolo in alto a sinistra in (x, page), ritagliato sui bordi
+ *      dello schermo. Le colonne vengono copiate dalla flash così come sono: nessuna ricerca dei glyph.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::drawStaticText (uint8_t x, uint8_t page, const uint8_t* data, uint16_t width, uint8_t pages, const bool inverted) {
+    if (!data || x >= COLUMNS || page >= PAGES) return;
+    const uint8_t w = (uint8_t)min<uint16_t>(width, COLUMNS - x);    // ritaglio sul bordo destro
+    const uint8_t n = (uint8_t)min<int>(pages, PAGES - page);        // ritaglio sul bordo inferiore
+    const uint8_t mask = inverted ? 0xFF : 0x00;
+    transaction([&] {
+        writeBlock(x, w, page, n, [&](uint8_t c, uint8_t p) {
+            return (uint8_t)(FONT_READ_U8(data + (uint16_t)c * pages + p) ^ mask);
+        });
+    });
+}
+
+/*
+ *  Function: drawText   
+ *  Desc: Scrive una stringa con il bordo superiore in (x, y), in pixel, con font di qualsiasi altezza.
+ *      Il testo viene ritagliato sui bordi dello schermo (nessun a capo). Come drawBitmap, le righe delle
+ *      pagine di bordo non coperte dal font vengono azzerate.
+ */
+template <class Transport>
+void PCD8544Base<Transport>::drawText (int16_t x, int16_t y, const char* str, const bool highlighted) {
+    if (!str) return;
+    drawRun(x, y, pcd8544::Utf8Source{str, str + strlen(str), false}, highlighted);
+}
+
+/*
+ *  Function: drawRun   
+ *  Desc: Come drawText, per i caratteri di una sorgente di codepoint (pcd8544::Utf8Source, pcd8544::Number,
+ *      o qualsiasi tipo con more() e next()). Usata dai widget che ridisegnano solo parte di un testo
+ *      (vedi gfx/TextField.h).
+ */
+template <class Transport>
+template <class Src>
+void PCD8544Base<Transport>::drawRun (int16_t x, int16_t y, Src src, const bool highlighted) {
+    if (!_fontReady) return;
+    transaction([&] { writeTextStrips(x, y, src, highlighted); });
+}
+
+/*
+ *  Function: writeTextStrips   
+ *  Desc: Invia il testo una striscia di pagina alla volta: per ogni pagina coperta un solo setXY() e un unico
+ *      burst con le colonne di tutti i caratteri, composte al volo dalle pagine dei glyph (y anche non
+ *      allineata a 8). Usa l'indirizzamento orizzontale. Va chiamata dentro transaction().
+ *      Con setTextScale(s) ogni colonna del glyph viene espansa in verticale con bits::spread (tabelle
+ *      nibble -> byte) e ripetuta s volte, senza font aggiuntivi in flash.
+ */
+template <class Transport>
+template <class Src>
+void PCD8544Base<Transport>::writeTextStrips (int16_t x, int16_t y, Src src, const bool inverted) {
+    if (!src.more()) return;
+    const uint8_t scale = textScale();
+    const int16_t srcPages = _font.pages();
+    const uint8_t height = (uint8_t)((_font.gHeight ? _font.gHeight : 8) * scale);
+    const int16_t gPages = (int16_t)(srcPages * scale);
+    const uint8_t spacing = (uint8_t)(_font.gSpacing * scale);
+    const int16_t total = (int16_t)(pcd8544::runWidth(_font, src) * scale);
+
+    // Ritaglio sui bordi dello schermo
+    const int16_t x0 = x < 0 ? 0 : x;
+    const int16_t x1 = min<int16_t>((int16_t)(x + total), COLUMNS);      // esclusivo
+    const int16_t y0 = y < 0 ? 0 : y;
+    const int16_t y1 = min<int16_t>((int16_t)(y + height), PAGES * 8);   // esclusivo
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const bool userV = addressing.current & FS_V;
+    setVerticalAddressing(false);
+
+    for (uint8_t page = (uint8_t)(y0 >> 3); page <= (uint8_t)((y1 - 1) >> 3); page++) {
+        const int16_t off = (int16_t)(page * 8 - y);     // riga del glyph in cima alla pagina
+        const uint8_t mask = pcd8544::bits::rowMask((int16_t)-off, height);
+        const uint8_t invert = inverted ? mask : 0x00;
+
+        // La striscia copre le pagine sp e sp + 1 del glyph, lette in parallelo da due flussi di colonne.
+        // Il testo ingrandito legge solo la pagina 0 (font alti 8 px) e la espande.
+        const int16_t sp = scale == 1 ? (int16_t)(off >> 3) : 0;
+        const uint8_t sh = (uint8_t)(off & 7);
+        const bool hasA = sp >= 0 && sp < srcPages;
+        const bool hasB = scale == 1 && sh && sp + 1 >= 0 && sp + 1 < srcPages;
+        pcd8544::ColumnStream a, b;
+
+        Src s = src;                    // ogni pagina rilegge i caratteri dall'inizio
+        uint8_t gw = 0, adv = 0;        // larghezza ingrandita del glyph e della cella
+        uint8_t col = 0;                // colonna (ingrandita) nella cella del carattere
+        uint32_t spreadCol = 0;         // colonna sorgente corrente espansa (solo scale > 1)
+        auto beginGlyph = [&] {
+            do {    // i glyph senza colonne né spaziatura vengono saltati, come in writeTextRun
+                const uint16_t cp = s.next();
+                if (hasA) { a.begin(_font, cp); a.skip((uint16_t)(sp * a.width())); }
+                if (hasB) { b.begin(_font, cp); b.skip((uint16_t)((sp + 1) * b.width())); }
+                gw = (uint8_t)((hasA ? a.width() : b.width()) * scale);
+                adv = (uint8_t)(gw + spacing);
+            } while (!adv && s.more());
+        };
+        auto column = [&]() -> uint8_t {
+            uint8_t out = 0x00;
+            if (col < gw) {
+                if (scale == 1) {
+                    const uint8_t va = hasA ? a.next() : 0;
+                    const uint8_t vb = hasB ? b.next() : 0;
+                    out = (uint8_t)((va >> sh) | (sh ? (uint8_t)(vb << (8 - sh)) : 0));
+                } else {
+                    // la colonna sorgente viene espansa una volta sola per le scale colonne ripetute
+                    if (col % scale == 0) spreadCol = pcd8544::bits::spread(a.next(), scale);
+                    out = pcd8544::bits::composeColumn([&](int16_t p) -> uint8_t {
+                        return (p >= 0 && p < gPages) ? (uint8_t)(spreadCol >> (8 * p)) : 0;
+                    }, off);
+                }
+            }
+            if (++col == adv) {
+                col = 0;
+                if (s.more()) beginGlyph();
+            }
+            return (uint8_t)((out & mask) ^ invert);
+        };
+
+        beginGlyph();
+        for (int16_t cx = x; cx < x0; cx++) column();     // colonne a sinistra dello schermo
+
+        setXY((uint8_t)x0, page);
+        dcData(); ceLow();
+        sendGenerated((size_t)(x1 - x0), [&](size_t) { return column(); });
+        ceHigh();
+    }
+    setVerticalAddressing(userV);
+}
+
+
+/*
+ *  Function: fillRow   
+ *  Desc: Colora interamente la riga selezionata (8x84 px)
+ */
+template <class Transport>
+void PCD8544Base<Transport>::fillRow (uint8_t y) {
+    transaction([&] {
+        setXY(0, y);
+        writeFill(0xFF, COLUMNS);
+    });
+}
+
+/*
+ *  Function: drawStraightLine   
+ *  Desc: Permette di creare una linea dritta, orizzontale o verticale.
+ *  Parametri:
+ *      - horizontal: true disegna linea orizzontale, false verticale
+ *      - c1: rappresenta la prima coordinata (inizio) della linea relativa alla sua direzione
+ *      - c2: rappresenta la seconda coordinata (fine) della linea relativa alla sua direzione
+ *      - oc: rappresenta la coordinata complementare. Se si è scelto il verso orizzontale rappresenterà
+ *            la y, altrimenti la x.
+ *      - borderWidth: rappresenta lo spessore della linea in pixel (da 0 a 8).
+ * 
+ *  N.B.
+ *  In questa funzione le y hanno come unità di misura i pixel e non le pagine ("righe") del display. Pertanto ogni y può assumere un 
+ *  valore da 0 a 48 px e NON da 0 a 6. Inoltre la funzione per poter funzionare correttamente è necessario tener conto delle 
+ *  dimensioni massime del display (in pixel).
+ */
+
+template <class Transport>
+void PCD8544Base<Transport>::drawStraightLine (uint8_t c1, uint8_t c2, uint8_t oc, bool horizontal, uint8_t borderWidth) {
+    if (borderWidth == 0) return;
+    const uint8_t HEIGHT = PAGES * 8;
+
+    if (horizontal) {
+        // --- linea orizzontale: X = c1..c2, Y = oc (spessore = borderWidth in pixel)
+        if (oc >= HEIGHT) oc = HEIGHT - 1;
+        if (c1 > c2) { uint8_t t = c1; c1 = c2; c2 = t; }
+        if (c1 >= COLUMNS) return;
+        if (c2 >= COLUMNS) c2 = COLUMNS - 1;
+
+        const uint8_t page   = oc >> 3;          // 0..5
+        const uint8_t yRest  = oc & 7;           // 0..7
+
+        // maschera sulla pagina corrente
+        uint8_t lowMask = ((uint8_t)0xFFu >> (8 - borderWidth));
+        lowMask = (uint8_t)( (lowMask << yRest) & 0xFFu );
+
+        // se lo spessore "sfonda" la pagina, prepara anche la maschera sulla pagina successiva
+        uint8_t highMask = 0;
+        if (yRest + borderWidth > 8) {
+            const uint8_t spill = (uint8_t)(yRest + borderWidth - 8); // 1..7
+            highMask = (uint8_t)(0xFFu >> (8 - spill));               // bit bassi
+        }
+
+        transaction([&] {
+            // pagina corrente
+            setXY(c1, page);
+            writeFill(lowMask, (size_t)(c2 - c1 + 1));
+
+            // eventuale pagina successiva
+            if (highMask && page + 1 < (HEIGHT / 8)) {
+                setXY(c1, (uint8_t)(page + 1));
+                writeFill(highMask, (size_t)(c2 - c1 + 1));
+            }
+        });
+
+    } else {
+        // --- linea verticale: Y = c1..c2, X = oc (spessore = borderWidth in colonne)
+        if (oc >= COLUMNS) return;
+        if (c1 > c2) { uint8_t t = c1; c1 = c2; c2 = t; }
+        if (c2 >= HEIGHT) c2 = HEIGHT - 1;
+
+        const uint8_t firstPage = c1 >> 3;       // pagina di partenza
+        const uint8_t lastPage  = c2 >> 3;       // pagina di arrivo
+        const uint8_t xEnd = (uint8_t)min<int>(oc + borderWidth - 1, COLUMNS - 1);
+
+        // Tutte le pagine di ogni colonna in un solo burst (indirizzamento verticale) quando conviene
+        transaction([&] {
+            writeBlock(oc, (uint8_t)(xEnd - oc + 1), firstPage, (uint8_t)(lastPage - firstPage + 1), [&](uint8_t, uint8_t p) {
+                const uint8_t page = (uint8_t)(firstPage + p);
+                // bit di inizio/fine all'interno della pagina
+                const uint8_t startBit = (page == firstPage) ? (c1 & 7) : 0;
+                const uint8_t endBit   = (page == lastPage)  ? (c2 & 7) : 7;
+
+                // maschera per i bit da startBit a endBit (inclusi)
+                uint8_t mask = (uint8_t)(0xFFu << startBit);
+                mask &= (uint8_t)(0xFFu >> (7 - endBit));
+                return mask;
+            });
+        });
+    }
+}
+/*void PCD8544::drawStraightLine (const uint8_t c1, const uint8_t c2, const uint8_t oc, const bool horizontal, const uint8_t borderWidth) {
+    if (horizontal) {
+        transaction([&] {
+            uint8_t yRest = (uint8_t)(oc % (uint8_t)8);
+            uint8_t y = (uint8_t)((oc / (uint8_t)8));
+
+            setXY(c1, y);
+            dcData(); ceLow();
+            uint8_t lineLen = c2 - c1 < 0 ? COLUMNS - c1 + c2 : c2 - c1;
+            for (uint8_t x = 0; x < lineLen; x++) {
+                uint8_t line = (uint8_t)pow((uint8_t)2, borderWidth) - 1;
+                _spi.transfer(0xFF & (line << yRest)); 
+            }
+        });
+    }
+}*/
+
+
+
+
+
+/*
+ *  Function: drawInRect   
+ *  Desc: Questa funzione permette di disegnare all'interno di uno spazio (rect) pre-determinato, passando un buffer di byte.
+ *      Equivale a drawBitmap con sorgente in RAM: buff contiene ceil(height / 8) righe da width byte.
+ *  Parametri: 
+ *      - x: coordinata x di inizio del rettangolo (vertice in alto a sinistra)
+ *      - y: coordinata y di inizio del rettangolo (vertice in alto a sinistra)
+ *      - width: larghezza del rettangolo
+ *      - height: altezza del rettangolo
+ *      - buff: buffer di byte da stampare sul display
+ */
+template <class Transport>
+void PCD8544Base<Transport>::drawInRect (const uint8_t x, const uint8_t y, const uint8_t width, const uint8_t height, const uint8_t* buff) {
+    drawBitmap(x, y, width, height, buff, false);
+}
+
+/*
+ *  Function: drawBitmap   
+ *  Desc: Disegna un'immagine di width x height pixel con il vertice in alto a sinistra in (x, y), y in pixel.
+ *      L'immagine è organizzata come i font: ceil(height / 8) righe ("pagine") da width byte, ogni byte è una
+ *      colonna di 8 pixel in LSB (bit 0 = pixel più in alto). Con y non multiplo di 8 ogni pagina del display
+ *      viene composta da due pagine consecutive della sorgente.
+ *      L'immagine viene ritagliata sui bordi dello schermo (x e y possono essere negativi) e ogni pagina del
+ *      display coperta viene inviata in un solo burst (vedi writeBlock).
+ *      N.B. Non essendoci un framebuffer, i bit delle pagine coperte che cadono fuori dall'immagine vengono azzerati.
+ *  Parametri: 
+ *      - x, y: posizione in pixel (anche negativa o oltre il bordo)
+ *      - width, height: dimensioni dell'immagine in pixel
+ *      - bmp: dati dell'immagine (ceil(height / 8) * width byte)
+ *      - progmem: true se bmp risiede in flash/PROGMEM (es. splash screen 84x48)
+ */
+template <class Transport>
+void PCD8544Base<Transport>::drawBitmap (int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t* bmp, const bool progmem) {
+    if (!bmp || width == 0 || height == 0) return;
+    const int16_t HEIGHT = PAGES * 8;
+
+    // Ritaglio sui bordi dello schermo
+    const int16_t x0 = x < 0 ? 0 : x;
+    const int16_t x1 = min<int16_t>((int16_t)(x + width), COLUMNS);          // esclusivo
+    const int16_t y0 = y < 0 ? 0 : y;
+    const int16_t y1 = min<int16_t>((int16_t)(y + height), HEIGHT);          // esclusivo
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const uint8_t srcPages = (uint8_t)((height + 7) >> 3);
+    const uint8_t pageStart = (uint8_t)(y0 >> 3);
+    const uint8_t pageEnd = (uint8_t)((y1 - 1) >> 3);
+
+    auto src = [&](int16_t sp, int16_t c) -> uint8_t {
+        if (sp < 0 || sp >= srcPages) return 0;
+        const uint8_t* p = bmp + (uint16_t)sp * width + c;
+        return progmem ? FONT_READ_U8(p) : *p;
+    };
+
+    transaction([&] {
+        writeBlock((uint8_t)x0, (uint8_t)(x1 - x0), pageStart, (uint8_t)(pageEnd - pageStart + 1), [&](uint8_t c, uint8_t p) {
+            const int16_t off = (int16_t)((pageStart + p) * 8 - y);     // riga della sorgente in cima alla pagina
+            const int16_t sc = (int16_t)(x0 - x + c);
+            const uint8_t b = pcd8544::bits::composeColumn([&](int16_t sp) { return src(sp, sc); }, off);
+            // solo le righe 0..height-1 della sorgente
+            return (uint8_t)(b & pcd8544::bits::rowMask((int16_t)-off, height));
+        });
+    });
+}
+
+/*
+ *  Function: writeRow   
+ *  Desc: Copia len byte da un buffer in RAM nella pagina page, a partire dalla colonna x, con un solo burst.
+ *      Usata per inviare le pagine dei canvas (vedi gfx/Canvas.h).
+ */
+template <class Transport>
+void PCD8544Base<Transport>::writeRow (uint8_t page, const uint8_t* buf, uint8_t x, uint8_t len) {
+    if (!buf || page >= PAGES || x >= COLUMNS) return;
+    if (len > COLUMNS - x) len = COLUMNS - x;
+    transaction([&] {
+        writeBlock(x, len, page, 1, [&](uint8_t c, uint8_t) { return buf[c]; });
+    });
+}
+
+/*
+ *  Function: writeRam   
+ *  Desc: Copia len byte nella DDRAM a partire dall'indirizzo lineare offset (pagina * 84 + colonna), con un
+ *      solo burst in indirizzamento orizzontale: alla fine di una pagina si prosegue sulla successiva.
+ *      Usata dal FrameBuffer per inviare le zone modificate (vedi gfx/Canvas.h).
+ */
+template <class Transport>
+void PCD8544Base<Transport>::writeRam (uint16_t offset, const uint8_t* buf, uint16_t len) {
+    if (!buf || offset >= MAX_BUFFER) return;
+    if (len > MAX_BUFFER - offset) len = MAX_BUFFER - offset;
+    if (!len) return;
+    transaction([&] {
+        setVerticalAddressing(false);
+        setXY((uint8_t)(offset % COLUMNS), (uint8_t)(offset / COLUMNS));
+        dcData(); ceLow();
+        sendBytes(buf, len);
+        ceHigh();
+        setVerticalAddressing(addressing.current & FS_V);
+    });
+}
+
+/*
+ *  Function: drawGenerated   
+ *  Desc: Disegna un blocco di width colonne x pages pagine a partire da (x, page), senza buffer: ogni byte
+ *      è calcolato da gen(colonna, pagina), relative al blocco, nel momento in cui viene inviato.
+ *      Usata dalla display list (vedi gfx/Scene.h).
+ */
+template <class Transport>
+template <class G>
+void PCD8544Base<Transport>::drawGenerated (uint8_t x, uint8_t page, uint8_t width, uint8_t pages, G&& gen) {
+    if (x >= COLUMNS || page >= PAGES) return;
+    if (width > COLUMNS - x) width = COLUMNS - x;
+    if (pages > PAGES - page) pages = PAGES - page;
+    transaction([&] { writeBlock(x, width, page, pages, gen); });
+}
+
+/*
+ *  Function: drawPacked   
+ *  Desc: Disegna un'immagine compressa con extras/tools/fontpack.py (ceil(h / 8) righe da width byte, vedi
+ *      font/ColumnStream.h), decodificata durante l'invio senza buffer in RAM: un burst per pagina.
+ *  Parametri: 
+ *      - x, page: colonna (0..83) e pagina (0..5) dell'angolo in alto a sinistra
+ *      - width, pages: dimensioni dell'immagine in colonne e pagine
+ *      - data, dict: flusso compresso e dizionario, in flash
+ */
+template <class Transport>
+void PCD8544Base<Transport>::drawPacked (const uint8_t x, const uint8_t page, const uint8_t width, const uint8_t pages, const uint8_t* data, const uint8_t* dict) {
+    if (!data || !dict || x >= COLUMNS || page >= PAGES) return;
+    const uint8_t w = (uint8_t)min<int>(width, COLUMNS - x);     // ritaglio sul bordo destro
+    const uint8_t n = (uint8_t)min<int>(pages, PAGES - page);    // ritaglio sul bordo inferiore
+    pcd8544::ColumnStream stream;
+    stream.beginPacked(data, dict);
+
+    transaction([&] {
+        const bool userV = addressing.current & FS_V;
+        setVerticalAddressing(false);
+        for (uint8_t p = 0; p < n; p++) {
+            setXY(x, (uint8_t)(page + p));
+            dcData(); ceLow();
+            sendGenerated(w, [&](size_t) { return stream.next(); });
+            ceHigh();
+            stream.skip((uint16_t)(width - w));
+        }
+        setVerticalAddressing(userV);
+    });
+}
+
+/*
+ *  Function: drawColumns   
+ *  Desc: Disegna un'immagine memorizzata per colonne (column-major): per ogni colonna ci sono "pages" byte
+ *      consecutivi, dalla pagina più alta alla più bassa. Le immagini alte vengono inviate con
+ *      l'indirizzamento verticale, una colonna intera per burst (vedi writeBlock).
+ *  Parametri: 
+ *      - x: colonna di inizio (0..83)
+ *      - page: pagina di inizio (0..5)
+ *      - width: numero di colonne
+ *      - pages: numero di pagine (altezza in multipli di 8 px)
+ *      - data: byte dell'immagine (width * pages)
+ *      - progmem: true se data risiede in flash/PROGMEM
+ */
+template <class Transport>
+void PCD8544Base<Transport>::drawColumns (const uint8_t x, const uint8_t page, const uint8_t width, const uint8_t pages, const uint8_t* data, const bool progmem) {
+    if (!data || x >= COLUMNS || page >= PAGES) return;
+    const uint8_t w = (uint8_t)min<int>(width, COLUMNS - x);     // ritaglio sul bordo destro
+    const uint8_t n = (uint8_t)min<int>(pages, PAGES - page);    // ritaglio sul bordo inferiore
+    transaction([&] {
+        writeBlock(x, w, page, n, [&](uint8_t c, uint8_t p) {
+            const uint8_t* src = data + (uint16_t)c * pages + p;
+            return progmem ? FONT_READ_U8(src) : *src;
+        });
+    });
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <stdint.h>
+#include "FontCompact.h"
+#include "FontInfo.h"
+#include "Glyph.h"
+
+/*
+ * ** ColumnStream **
+ * Lettura sequenziale delle colonne di un glyph o di un'immagine, in formato normale o compresso
+ * (FLAGS bit 1, vedi font/README.md). Il decoder lavora direttamente sulla flash, senza buffer in RAM:
+ * ogni chiamata a next() ritorna il byte successivo (pagina per pagina per i glyph alti più di 8 px).
+ *
+ * Formato compresso: sequenza di codici da 4 bit (nibble alto per primo)
+ *      0x0         colonna vuota (0x00)
+ *      0x1         ripete la colonna precedente (0x00 all'inizio di ogni glyph)
+ *      0x2 - 0xE   colonna del dizionario dict[codice - 2]
+ *      0xF         letterale: i due nibble successivi sono il byte (prima quello alto)
+ */
+namespace pcd8544 {
+
+class ColumnStream {
+public:
+    /*
+     *  Function: begin
+     *  Desc: Si posiziona sulla prima colonna del glyph del codepoint cp. Nei font compressi l'indice
+     *      (offsets) contiene la posizione, in nibble, di un glyph ogni 8: i glyph precedenti del gruppo
+     *      vengono saltati leggendo solo i codici.
+     */
+    inline void begin (const FontInfo& f, uint16_t cp) {
+        if (!f.isPacked()) {
+            const Glyph g = findGlyph(f, cp);
+            beginRaw(g.data);
+            _width = g.width;
+            return;
+        }
+        const uint16_t i = glyphIndex(f, cp);
+        beginPacked(f.data, f.dict, FONT_READ_U16(f.offsets + (i >> 3)));
+        for (uint16_t n = (uint16_t)((i & 7) * f.gWidth * f.pages()); n; n--) {
+            _nib = (uint16_t)(_nib + (code(_nib) == 0xF ? 3 : 1));
+        }
+        _width = f.gWidth;
+    }
+    // Immagine o glyph non compresso in flash
+    inline void beginRaw (const uint8_t* data) {
+        _p = data;
+        _dict = nullptr;
+        _prev = 0;
+    }
+    // Flusso compresso che inizia al nibble nib di data
+    inline void beginPacked (const uint8_t* data, const uint8_t* dict, uint16_t nib = 0) {
+        _p = data;
+        _dict = dict;
+        _nib = nib;
+        _prev = 0;
+    }
+
+    inline uint8_t width () const { return _width; }
+
+    inline uint8_t next () {
+        if (!_dict) return FONT_READ_U8(_p++);
+        const uint8_t code = nibble();
+        if (code == 0x0) _prev = 0x00;
+        else if (code == 0xF) {
+            const uint8_t hi = nibble();
+            _prev = (uint8_t)((hi << 4) | nibble());
+        }
+        else if (code != 0x1) _prev = FONT_READ_U8(_dict + code - 2);
+        return _prev;
+    }
+
+    // Salta n colonne. Nel formato compresso vengono decodificate, perché la colonna successiva
+    // può ripetere l'ultima saltata (solo i glyph interi si saltano leggendo i codici, vedi begin()).
+    inline void skip (uint16_t n) {
+        if (!_dict) { _p += n; return; }
+        while (n--) next();
+    }
+
+private:
+    const uint8_t* _p = nullptr;
+    const uint8_t* _dict = nullptr;
+    uint16_t _nib = 0;
+    uint8_t _prev = 0;
+    uint8_t _width = 0;
+
+    inline uint8_t code (uint16_t nib) const {
+        const uint8_t b = FONT_READ_U8(_p + (nib >> 1));
+        return (nib & 1) ? (uint8_t)(b & 0x0F) : (uint8_t)(b >> 4);
+    }
+    inline uint8_t nibble () { return code(_nib++); }
+};
+
+}
@@ -3,8 +3,10 @@
   #define FONT_PROGMEM PROGMEM
   #define FONT_READ_U8(p)  pgm_read_byte(p)
   #define FONT_READ_U16(p) pgm_read_word(p)
+  #define FONT_READ_U32(p) pgm_read_dword(p)
 #else
   #define FONT_PROGMEM
   #define FONT_READ_U8(p)  (*(const uint8_t*)(p))
   #define FONT_READ_U16(p) (*(const uint16_t*)(p))
+  #define FONT_READ_U32(p) (*(const uint32_t*)(p))
 #endif
\ No newline at end of file
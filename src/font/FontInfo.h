@@ -3,6 +3,20 @@
 #include <stdint.h>
 
 namespace pcd8544 {
+
+// FLAGS bit 0: font a larghezza variabile, bit 1: dati compressi, bit 2: range di codepoint aggiuntivi
+// (vedi font/README.md)
+static constexpr uint8_t FONT_FLAG_VARIABLE = 0x01;
+static constexpr uint8_t FONT_FLAG_PACKED = 0x02;
+static constexpr uint8_t FONT_FLAG_SPARSE = 0x04;
+
+// Range di codepoint [first, last] i cui glyph seguono quelli del range principale, a partire dal glyph index
+struct CodeRange {
+    uint16_t first;
+    uint16_t last;
+    uint16_t index;
+};
+
 struct FontInfo {
     uint8_t flags;
     uint16_t first; 
@@ -11,5 +25,23 @@ struct FontInfo {
     uint8_t gWidth; 
     uint8_t gSpacing;
     const uint8_t* data;
+    // Campi opzionali: nullptr / 0 se non usati. FontInfo resta un aggregato C++11 (il core AVR compila con
+    // gnu++11): niente inizializzatori di default, ogni istanza elenca tutti i campi.
+    const uint16_t* offsets;    // font variabili: (numero di glyph + 1) offset in data, in flash
+                                // font compressi: posizione in nibble di un glyph ogni 8
+    const uint8_t* dict;        // solo font compressi: dizionario delle colonne (13 byte), in flash
+    const CodeRange* ranges;    // solo FONT_FLAG_SPARSE: range aggiuntivi ordinati per codepoint, in flash
+    uint8_t rangeCount;
+
+    // Pagine (righe da 8 px) occupate da ogni glyph
+    constexpr uint8_t pages () const { return gHeight > 8 ? (uint8_t)((gHeight + 7) >> 3) : 1; }
+    constexpr bool isVariable () const { return (flags & FONT_FLAG_VARIABLE) && offsets && !(flags & FONT_FLAG_PACKED); }
+    // I font compressi sono sempre a larghezza fissa
+    constexpr bool isPacked () const { return (flags & FONT_FLAG_PACKED) && offsets && dict && gWidth; }
+    constexpr bool isSparse () const { return (flags & FONT_FLAG_SPARSE) && ranges && rangeCount; }
+    // Font utilizzabile: dati presenti e larghezza fissa oppure tabella degli offset
+    constexpr bool isValid () const {
+        return data && first <= last && (flags & FONT_FLAG_PACKED ? isPacked() : (gWidth || isVariable()));
+    }
 };
-}
\ No newline at end of file
+}
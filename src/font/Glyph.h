@@ -0,0 +1,89 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "FontCompact.h"
+#include "FontInfo.h"
+#include "Utf8.h"
+
+namespace pcd8544 {
+
+// Colonne (in flash) e larghezza di un glyph. I glyph alti più di 8 px sono memorizzati per pagine:
+// width byte della prima pagina, poi width byte della seconda, ... (come le immagini di drawBitmap)
+struct Glyph {
+    const uint8_t* data;
+    uint8_t width;
+
+    // Byte della pagina page (0 = in alto), colonna col. Nessun controllo sui limiti.
+    inline uint8_t column (uint8_t page, uint8_t col) const { return FONT_READ_U8(data + (uint16_t)page * width + col); }
+};
+
+/*
+ *  Function: findRange   
+ *  Desc: Indice del glyph di cp nei range aggiuntivi (ricerca binaria), -1 se assente.
+ */
+inline int32_t findRange (const FontInfo& f, uint16_t cp) {
+    if (!f.isSparse()) return -1;
+    uint8_t lo = 0, hi = f.rangeCount;
+    while (lo < hi) {
+        const uint8_t mid = (uint8_t)((lo + hi) >> 1);
+        const CodeRange* r = f.ranges + mid;
+        if (cp < FONT_READ_U16(&r->first)) hi = mid;
+        else if (cp > FONT_READ_U16(&r->last)) lo = (uint8_t)(mid + 1);
+        else return (int32_t)FONT_READ_U16(&r->index) + (cp - FONT_READ_U16(&r->first));
+    }
+    return -1;
+}
+
+/*
+ *  Function: glyphIndex   
+ *  Desc: Posizione del glyph di cp nei dati del font: O(1) nel range principale [first, last], O(log n) nei
+ *      range aggiuntivi. I codepoint assenti vengono sostituiti con '?' (o con il primo glyph se anche '?'
+ *      non è presente).
+ */
+inline uint16_t glyphIndex (const FontInfo& f, uint16_t cp) {
+    if (cp >= f.first && cp <= f.last) return (uint16_t)(cp - f.first);
+    const int32_t r = findRange(f, cp);
+    if (r >= 0) return (uint16_t)r;
+    if ((uint16_t)'?' >= f.first && (uint16_t)'?' <= f.last) return (uint16_t)('?' - f.first);
+    return 0;
+}
+
+/*
+ *  Function: findGlyph   
+ *  Desc: Ritorna il glyph del codepoint cp (vedi glyphIndex).
+ */
+inline Glyph findGlyph (const FontInfo& f, uint16_t cp) {
+    const uint16_t i = glyphIndex(f, cp);
+    if (f.isVariable()) {
+        // glyph i: byte [offsets[i], offsets[i + 1]) di data
+        const uint16_t o0 = FONT_READ_U16(f.offsets + i);
+        const uint16_t o1 = FONT_READ_U16(f.offsets + i + 1);
+        return { f.data + o0, (uint8_t)((o1 - o0) / f.pages()) };
+    }
+    return { f.data + i * f.gWidth * f.pages(), f.gWidth };
+}
+
+/*
+ *  Function: runWidth   
+ *  Desc: Larghezza in pixel dei caratteri di una sorgente di codepoint (Utf8Source, Number), spaziatura
+ *      compresa. La sorgente viene copiata: quella del chiamante non avanza.
+ */
+template <class Src>
+inline uint16_t runWidth (const FontInfo& f, Src src) {
+    uint16_t w = 0;
+    while (src.more()) {
+        const uint16_t cp = src.next();
+        w = (uint16_t)(w + (f.isVariable() ? findGlyph(f, cp).width : f.gWidth) + f.gSpacing);
+    }
+    return w;
+}
+
+/*
+ *  Function: textWidth   
+ *  Desc: Larghezza in pixel dei primi len byte di str, in UTF-8 (spaziatura compresa), da RAM o flash.
+ */
+inline uint16_t textWidth (const FontInfo& f, const char* str, size_t len, bool progmem = false) {
+    return str ? runWidth(f, Utf8Source{str, str + len, progmem}) : 0;
+}
+
+}
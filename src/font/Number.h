@@ -0,0 +1,82 @@
+#pragma once
+#include <stdint.h>
+#include "FontCompact.h"
+
+/*
+ * ** Number **
+ * Formattazione di interi e numeri a virgola fissa senza stringhe intermedie: i caratteri vengono prodotti
+ * uno alla volta, dalla cifra più significativa, e il driver ne invia subito le colonne (vedi print()).
+ * Ogni cifra si ottiene sottraendo la potenza di 10 corrispondente (al massimo 9 sottrazioni), senza
+ * divisioni né aritmetica in virgola mobile.
+ *
+ *      lcd.print(pcd8544::Number(tempX10, {1, 5}));         // 215 -> " 21.5"
+ *      lcd.print(pcd8544::Number(count, {0, 4, '0'}));      // 42  -> "0042"
+ */
+namespace pcd8544 {
+
+// Costruttore constexpr invece di inizializzatori di default: {1, 5} e {} funzionano anche in C++11 (core AVR)
+struct NumberFormat {
+    uint8_t decimals;   // cifre dopo il punto: il valore è espresso in unità di 10^-decimals
+    uint8_t width;      // larghezza minima in caratteri (segno e punto compresi)
+    char pad;           // riempimento a sinistra: ' ' (prima del segno) o '0' (dopo il segno)
+    bool plus;          // '+' davanti ai valori positivi
+
+    constexpr NumberFormat (uint8_t d = 0, uint8_t w = 0, char p = ' ', bool sign = false)
+        : decimals(d), width(w), pad(p), plus(sign) {}
+};
+
+// 10^0 .. 10^9, in flash
+static const uint32_t POW10[10] FONT_PROGMEM = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL,
+};
+
+class Number {
+public:
+    static constexpr uint8_t MAX_DECIMALS = 9;
+
+    Number (int value, NumberFormat fmt = {}) : Number((long)value, fmt) {}
+    Number (unsigned int value, NumberFormat fmt = {}) : Number((unsigned long)value, fmt) {}
+    Number (long value, NumberFormat fmt = {})
+        : Number(value < 0 ? (uint32_t)(0UL - (unsigned long)value) : (uint32_t)value, value < 0, fmt) {}
+    Number (unsigned long value, NumberFormat fmt = {}) : Number((uint32_t)value, false, fmt) {}
+
+    // Numero di caratteri prodotti
+    inline uint8_t length () const { return (uint8_t)(_lead + (_sign ? 1 : 0) + _zeros + _digits + (_decimals ? 1 : 0)); }
+
+    // Interfaccia di sorgente dei renderer di testo (come Utf8Source)
+    inline bool more () const { return _lead || _sign || _zeros || _digits; }
+    inline uint16_t next () {
+        if (_lead) { _lead--; return ' '; }
+        if (_sign) { const char s = _sign; _sign = 0; return (uint8_t)s; }
+        if (_zeros) { _zeros--; return '0'; }
+        if (_dot) { _dot = false; return '.'; }
+        const uint8_t k = --_digits;
+        const uint32_t p = FONT_READ_U32(POW10 + k);
+        uint8_t d = '0';
+        while (_mag >= p) { _mag -= p; d++; }
+        if (_decimals && k == _decimals) _dot = true;   // il punto segue la cifra delle unità
+        return d;
+    }
+
+private:
+    uint32_t _mag;          // cifre ancora da produrre
+    char _sign = 0;
+    bool _dot = false;
+    uint8_t _decimals;
+    uint8_t _lead = 0;      // spazi prima del segno
+    uint8_t _zeros = 0;     // zeri di riempimento dopo il segno
+    uint8_t _digits = 1;    // cifre rimanenti (punto escluso)
+
+    Number (uint32_t mag, bool negative, const NumberFormat& fmt)
+        : _mag(mag), _decimals(fmt.decimals > MAX_DECIMALS ? MAX_DECIMALS : fmt.decimals) {
+        while (_digits < 10 && mag >= FONT_READ_U32(POW10 + _digits)) _digits++;
+        if (_digits <= _decimals) _digits = (uint8_t)(_decimals + 1);     // "0.05", non ".05"
+        _sign = negative ? '-' : (fmt.plus ? '+' : 0);
+        const uint8_t body = length();
+        const uint8_t fill = fmt.width > body ? (uint8_t)(fmt.width - body) : 0;
+        if (fmt.pad == '0') _zeros = fill;
+        else _lead = fill;
+    }
+};
+
+}
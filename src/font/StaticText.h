@@ -0,0 +1,126 @@
+#pragma once
+#include <stdint.h>
+#include "FontCompact.h"
+#include "FontInfo.h"
+
+/*
+ * ** StaticText **
+ * Testo costante pre-renderizzato in compilazione: una stringa letterale (UTF-8) e un font diventano un array
+ * di colonne in flash, che print() e drawStatic() inviano con un unico burst, senza cercare i glyph né
+ * calcolare le larghezze a runtime.
+ *
+ *      PCD8544_STATIC_TEXT(LBL_TEMP, MONO_5x7, "Temp. °C");
+ *      lcd.setCursor(0, 1);
+ *      lcd.print(LBL_TEMP);
+ *
+ * I dati del font devono essere constexpr (come quelli dei font inclusi) e il file data.h va incluso prima
+ * della macro. I font compressi non sono supportati. Ogni testo occupa larghezza * pagine byte di flash:
+ * conviene per le etichette brevi e ricorrenti, non per i testi lunghi.
+ */
+namespace pcd8544 {
+
+// Testo di W colonne (spaziatura finale compresa) e P pagine, memorizzato per colonne (come drawColumns)
+template <uint16_t W, uint8_t P = 1>
+struct StaticText {
+    static_assert(W > 0, "StaticText: testo vuoto");
+    static_assert((uint32_t)W * P <= 504, "StaticText: testo più grande dello schermo");
+    static constexpr uint16_t WIDTH = W;
+    static constexpr uint8_t PAGES = P;
+    uint8_t data[(uint16_t)W * P];
+};
+
+/*
+ *  Versioni constexpr di utf8Next(), glyphIndex() e findGlyph(): in compilazione i dati del font si leggono
+ *  direttamente, senza FONT_READ_*. Sono scritte come funzioni constexpr C++11 (una sola espressione, cicli
+ *  come ricorsione): il core Arduino AVR compila con gnu++11.
+ */
+namespace prerender {
+
+// Chiamata solo se il font non è utilizzabile: interrompe la compilazione con il suo nome nel messaggio
+void fontNotSupported ();
+
+// UTF-8: byte di continuazione attesi dopo il primo byte b0 (0 per ASCII e byte non validi)
+constexpr uint8_t trailCount (uint8_t b0) {
+    return (b0 & 0xE0) == 0xC0 ? 1 : (b0 & 0xF0) == 0xE0 ? 2 : (b0 & 0xF8) == 0xF0 ? 3 : 0;
+}
+// p[i..n] sono byte di continuazione (si ferma al primo che non lo è, es. il terminatore)
+constexpr bool trailValid (const char* p, uint8_t i, uint8_t n) {
+    return i > n || ((((uint8_t)p[i]) & 0xC0) == 0x80 && trailValid(p, (uint8_t)(i + 1), n));
+}
+// Byte occupati dal carattere in p: una sequenza non valida conta 1 byte (come utf8Next())
+constexpr uint8_t charLength (const char* p) {
+    return trailValid(p, 1, trailCount((uint8_t)*p)) ? (uint8_t)(trailCount((uint8_t)*p) + 1) : 1;
+}
+constexpr uint16_t decodeTrail (const char* p, uint8_t i, uint8_t n, uint16_t cp) {
+    return i > n ? cp : decodeTrail(p, (uint8_t)(i + 1), n, (uint16_t)((cp << 6) | ((uint8_t)p[i] & 0x3F)));
+}
+// Codepoint del carattere in p; le sequenze di 4 byte (fuori dal BMP) diventano U+FFFD
+constexpr uint16_t codepointAt (const char* p) {
+    return charLength(p) == 1 ? (uint16_t)(uint8_t)*p
+        : charLength(p) == 4 ? (uint16_t)0xFFFD
+        : decodeTrail(p, 1, (uint8_t)(charLength(p) - 1),
+            (uint16_t)((uint8_t)*p & (charLength(p) == 2 ? 0x1F : 0x0F)));
+}
+
+// Indice del glyph di cp nei range aggiuntivi a partire dal range r, 0xFFFF se assente
+constexpr uint16_t rangeIndex (const FontInfo& f, uint16_t cp, uint8_t r) {
+    return r >= f.rangeCount ? (uint16_t)0xFFFF
+        : (cp >= f.ranges[r].first && cp <= f.ranges[r].last) ? (uint16_t)(f.ranges[r].index + cp - f.ranges[r].first)
+        : rangeIndex(f, cp, (uint8_t)(r + 1));
+}
+constexpr uint16_t codepointIndex (const FontInfo& f, uint16_t cp) {
+    return (cp >= f.first && cp <= f.last) ? (uint16_t)(cp - f.first)
+        : (f.isSparse() && rangeIndex(f, cp, 0) != 0xFFFF) ? rangeIndex(f, cp, 0)
+        : ((uint16_t)'?' >= f.first && (uint16_t)'?' <= f.last) ? (uint16_t)('?' - f.first)
+        : (uint16_t)0;
+}
+
+// Offset del glyph i in f.data e sua larghezza
+constexpr uint16_t glyphOffset (const FontInfo& f, uint16_t i) {
+    return f.isVariable() ? f.offsets[i] : (uint16_t)(i * f.gWidth * f.pages());
+}
+constexpr uint8_t glyphWidth (const FontInfo& f, uint16_t i) {
+    return f.isVariable() ? (uint8_t)((f.offsets[i + 1] - f.offsets[i]) / f.pages()) : f.gWidth;
+}
+// Glyph del carattere in p e colonne che occupa (spaziatura compresa)
+constexpr uint16_t glyphAt (const FontInfo& f, const char* p) { return codepointIndex(f, codepointAt(p)); }
+constexpr uint16_t advance (const FontInfo& f, const char* p) { return (uint16_t)(glyphWidth(f, glyphAt(f, p)) + f.gSpacing); }
+
+constexpr uint16_t widthFrom (const FontInfo& f, const char* p) {
+    return *p ? (uint16_t)(advance(f, p) + widthFrom(f, p + charLength(p))) : (uint16_t)0;
+}
+// Larghezza in pixel di str, spaziatura finale compresa (come textWidth())
+constexpr uint16_t width (const FontInfo& f, const char* str) {
+    return (!f.isValid() || f.isPacked()) ? (fontNotSupported(), (uint16_t)0) : widthFrom(f, str);
+}
+
+// Byte della pagina page nella colonna x del testo che inizia in p (0 nella spaziatura e oltre la fine)
+constexpr uint8_t columnByte (const FontInfo& f, const char* p, uint16_t x, uint8_t page) {
+    return !*p ? (uint8_t)0
+        : x < glyphWidth(f, glyphAt(f, p))
+            ? f.data[glyphOffset(f, glyphAt(f, p)) + page * glyphWidth(f, glyphAt(f, p)) + x]
+        : x < advance(f, p) ? (uint8_t)0
+        : columnByte(f, p + charLength(p), (uint16_t)(x - advance(f, p)), page);
+}
+
+// Sequenza 0..N-1 di indici dei byte di StaticText (al posto di std::make_index_sequence, C++14)
+template <uint16_t... I> struct Indices {};
+template <uint16_t N, uint16_t... I> struct MakeIndices : MakeIndices<(uint16_t)(N - 1), (uint16_t)(N - 1), I...> {};
+template <uint16_t... I> struct MakeIndices<0, I...> { typedef Indices<I...> type; };
+
+template <uint16_t W, uint8_t P, uint16_t... I>
+constexpr StaticText<W, P> renderIndices (const FontInfo& f, const char* str, Indices<I...>) {
+    return StaticText<W, P> {{ columnByte(f, str, (uint16_t)(I / P), (uint8_t)(I % P))... }};
+}
+template <uint16_t W, uint8_t P>
+constexpr StaticText<W, P> render (const FontInfo& f, const char* str) {
+    return renderIndices<W, P>(f, str, typename MakeIndices<(uint16_t)(W * P)>::type());
+}
+
+}
+}
+
+// Dichiara in flash il testo name, renderizzato in compilazione con font
+#define PCD8544_STATIC_TEXT(name, font, str) \
+    static constexpr auto name FONT_PROGMEM = \
+        pcd8544::prerender::render<pcd8544::prerender::width(font, str), (font).pages()>(font, str)
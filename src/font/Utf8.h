@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+#include "FontCompact.h"
+
+namespace pcd8544 {
+
+/*
+ *  Function: utf8Next   
+ *  Desc: Decodifica il codepoint UTF-8 che inizia in p (RAM o flash) e avanza p al successivo, senza
+ *      superare end. Le sequenze da 2 e 3 byte coprono tutto il piano base (U+0000 - U+FFFF); quelle da
+ *      4 byte ritornano U+FFFD. Un byte che non inizia una sequenza valida viene letto come Latin-1
+ *      (es. print('\xB0') stampa '°').
+ */
+inline uint16_t utf8Next (const char*& p, const char* end, bool progmem = false) {
+    auto rd = [&](const char* q) { return progmem ? (uint8_t)FONT_READ_U8(q) : (uint8_t)*q; };
+    const uint8_t b0 = rd(p);
+    uint8_t n;
+    uint16_t cp;
+    if (b0 < 0x80) { p++; return b0; }
+    else if ((b0 & 0xE0) == 0xC0) { n = 1; cp = (uint16_t)(b0 & 0x1F); }
+    else if ((b0 & 0xF0) == 0xE0) { n = 2; cp = (uint16_t)(b0 & 0x0F); }
+    else if ((b0 & 0xF8) == 0xF0) { n = 3; cp = 0; }
+    else { p++; return b0; }
+
+    if (end - p <= n) { p++; return b0; }
+    for (uint8_t i = 1; i <= n; i++) {
+        const uint8_t b = rd(p + i);
+        if ((b & 0xC0) != 0x80) { p++; return b0; }
+        cp = (uint16_t)((cp << 6) | (b & 0x3F));
+    }
+    p += n + 1;
+    return n == 3 ? 0xFFFD : cp;
+}
+
+// Sorgente di codepoint per i renderer di testo: i byte [p, end) in UTF-8, da RAM o flash
+struct Utf8Source {
+    const char* p;
+    const char* end;
+    bool progmem;
+    inline bool more () const { return p < end; }
+    inline uint16_t next () { return utf8Next(p, end, progmem); }
+};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <stdint.h>
+#include "../FontCompact.h"
+
+// Cifre 10x16 px (codepoint 32..58) ricavate da mono_5x8px raddoppiando ogni pixel.
+// Ogni glyph: 10 byte della pagina superiore, poi 10 byte della pagina inferiore.
+
+constexpr uint8_t DIGITS_10x16_DATA[] FONT_PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,   // space
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,   // !
+    0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00,   // "
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x30, 0x30, 0xFF, 0xFF, 0x30, 0x30, 0xFF, 0xFF, 0x30, 0x30,   // #
+    0x03, 0x03, 0x3F, 0x3F, 0x03, 0x03, 0x3F, 0x3F, 0x03, 0x03,
+    0x30, 0x30, 0xCC, 0xCC, 0xFF, 0xFF, 0xCC, 0xCC, 0x0C, 0x0C,   // $
+    0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x3F, 0x0C, 0x0C, 0x03, 0x03,
+    0x0F, 0x0F, 0x0F, 0x0F, 0xC0, 0xC0, 0x30, 0x30, 0x0C, 0x0C,   // %
+    0x0C, 0x0C, 0x03, 0x03, 0x00, 0x00, 0x0F, 0x0F, 0x0F, 0x0F,
+    0x3C, 0x3C, 0xC3, 0xC3, 0x33, 0x33, 0x0C, 0x0C, 0x00, 0x00,   // &
+    0x0F, 0x0F, 0x30, 0x30, 0x33, 0x33, 0x0C, 0x0C, 0x33, 0x33,
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00,   // '
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF0, 0xF0, 0x0C, 0x0C, 0x03, 0x03, 0x00, 0x00,   // (
+    0x00, 0x00, 0x03, 0x03, 0x0C, 0x0C, 0x30, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0x03, 0x0C, 0x0C, 0xF0, 0xF0, 0x00, 0x00,   // )
+    0x00, 0x00, 0x30, 0x30, 0x0C, 0x0C, 0x03, 0x03, 0x00, 0x00,
+    0x30, 0x30, 0xC0, 0xC0, 0xFC, 0xFC, 0xC0, 0xC0, 0x30, 0x30,   // *
+    0x03, 0x03, 0x00, 0x00, 0x0F, 0x0F, 0x00, 0x00, 0x03, 0x03,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0,   // +
+    0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,   // ,
+    0x00, 0x00, 0x33, 0x33, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,   // -
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,   // .
+    0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0x30, 0x30, 0x0C, 0x0C,   // /
+    0x0C, 0x0C, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFC, 0xFC, 0x03, 0x03, 0xC3, 0xC3, 0x33, 0x33, 0xFC, 0xFC,   // 0
+    0x0F, 0x0F, 0x33, 0x33, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+    0x00, 0x00, 0x0C, 0x0C, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,   // 1
+    0x00, 0x00, 0x30, 0x30, 0x3F, 0x3F, 0x30, 0x30, 0x00, 0x00,
+    0x0C, 0x0C, 0x03, 0x03, 0x03, 0x03, 0xC3, 0xC3, 0x3C, 0x3C,   // 2
+    0x30, 0x30, 0x3C, 0x3C, 0x33, 0x33, 0x30, 0x30, 0x30, 0x30,
+    0x03, 0x03, 0x03, 0x03, 0x33, 0x33, 0xCF, 0xCF, 0x03, 0x03,   // 3
+    0x0C, 0x0C, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+    0xC0, 0xC0, 0x30, 0x30, 0x0C, 0x0C, 0xFF, 0xFF, 0x00, 0x00,   // 4
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x3F, 0x3F, 0x03, 0x03,
+    0x3F, 0x3F, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xC3, 0xC3,   // 5
+    0x0C, 0x0C, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+    0xF0, 0xF0, 0xCC, 0xCC, 0xC3, 0xC3, 0xC3, 0xC3, 0x00, 0x00,   // 6
+    0x0F, 0x0F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+    0x0F, 0x0F, 0x03, 0x03, 0x03, 0x03, 0xC3, 0xC3, 0x3F, 0x3F,   // 7
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00,
+    0x3C, 0x3C, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x3C, 0x3C,   // 8
+    0x0F, 0x0F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+    0x3C, 0x3C, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFC, 0xFC,   // 9
+    0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x0C, 0x0C, 0x03, 0x03,
+    0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0x00, 0x00,   // :
+    0x00, 0x00, 0x0F, 0x0F, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00,
+};
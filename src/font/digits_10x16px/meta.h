@@ -0,0 +1,27 @@
+#pragma once
+#include <stdint.h>
+#include "../FontCompact.h"
+#include "../FontInfo.h"
+
+static constexpr uint8_t DIGITS_10x16_FLAGS = 0x10;
+static constexpr uint16_t DIGITS_10x16_FIRST_CODEPOINT = 32;
+static constexpr uint16_t DIGITS_10x16_LAST_CODEPOINT = 58;
+static constexpr uint8_t DIGITS_10x16_GLYPH_HEIGHT = 16;
+static constexpr uint8_t DIGITS_10x16_GLYPH_WIDTH = 10;
+static constexpr uint8_t DIGITS_10x16_GLYPH_SPACING = 2;
+
+extern const uint8_t DIGITS_10x16_DATA[] FONT_PROGMEM;
+
+static constexpr pcd8544::FontInfo DIGITS_10x16 {
+    DIGITS_10x16_FLAGS,
+    DIGITS_10x16_FIRST_CODEPOINT,
+    DIGITS_10x16_LAST_CODEPOINT,
+    DIGITS_10x16_GLYPH_HEIGHT,
+    DIGITS_10x16_GLYPH_WIDTH,
+    DIGITS_10x16_GLYPH_SPACING,
+    DIGITS_10x16_DATA,
+    nullptr,
+    nullptr,
+    nullptr,
+    0
+};
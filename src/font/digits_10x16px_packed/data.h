@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+#include "../FontCompact.h"
+
+// Compresso da extras/tools/fontpack.py: 292 byte (dati 271 + indice 8 + dizionario 13) invece di 540
+
+const uint8_t DIGITS_10x16_PACKED_DATA[] FONT_PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB1, 0x00, 0x00, 0x00,
+    0x00, 0x71, 0x00, 0x00, 0x00, 0x61, 0x00, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0xB1,
+    0x21, 0xB1, 0x21, 0x31, 0x61, 0x31, 0x61, 0x31, 0x21, 0xD1, 0xB1, 0xD1, 0x41, 0x11, 0x11, 0x61,
+    0x41, 0x31, 0x51, 0x11, 0x81, 0x21, 0x41, 0x11, 0x31, 0x00, 0x51, 0x11, 0x91, 0xA1, 0x71, 0x41,
+    0x00, 0x51, 0x21, 0x71, 0x41, 0x71, 0x00, 0x00, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xE1, 0x41, 0x31, 0x00, 0x00, 0x31, 0x41, 0x21, 0x00, 0x00, 0x31, 0x41, 0xE1, 0x00, 0x00,
+    0x21, 0x41, 0x31, 0x00, 0x21, 0x81, 0xC1, 0x81, 0x21, 0x31, 0x00, 0x51, 0x00, 0x31, 0x81, 0x11,
+    0xC1, 0x81, 0x11, 0x00, 0x00, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x71, 0x51,
+    0x00, 0x00, 0x81, 0x11, 0x11, 0x11, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x91, 0x11, 0x00, 0x00, 0x00, 0x00, 0x81, 0x21, 0x41, 0x11, 0x31, 0x00, 0x00, 0x00,
+    0xC1, 0x31, 0xA1, 0x71, 0xC1, 0x51, 0x71, 0x21, 0x11, 0x51, 0x00, 0x41, 0xB1, 0x00, 0x00, 0x00,
+    0x21, 0x61, 0x21, 0x00, 0x41, 0x31, 0x11, 0xA1, 0x91, 0x21, 0x91, 0x71, 0x21, 0x11, 0x31, 0x11,
+    0x71, 0xFC, 0xF1, 0x31, 0x41, 0x21, 0x11, 0x11, 0x51, 0x81, 0x21, 0x41, 0xB1, 0x00, 0x31, 0x11,
+    0x11, 0x61, 0x31, 0x61, 0x71, 0x11, 0x11, 0xA1, 0x41, 0x21, 0x11, 0x11, 0x51, 0xE1, 0xD1, 0xA1,
+    0x11, 0x00, 0x51, 0x21, 0x11, 0x11, 0x51, 0x51, 0x31, 0x11, 0xA1, 0x61, 0x00, 0x00, 0x61, 0x00,
+    0x00, 0x91, 0xA1, 0x11, 0x11, 0x91, 0x51, 0x21, 0x11, 0x11, 0x51, 0x91, 0xA1, 0x11, 0x11, 0xC1,
+    0x00, 0x21, 0x11, 0x41, 0x31, 0x00, 0x91, 0x11, 0x00, 0x00, 0x00, 0x51, 0x11, 0x00, 0x00,
+};
+
+// Posizione (in nibble) dei glyph 0, 8, 16, ...
+const uint16_t DIGITS_10x16_PACKED_INDEX[] FONT_PROGMEM = {
+    0, 160, 320, 482,
+};
+
+const uint8_t DIGITS_10x16_PACKED_DICT[] FONT_PROGMEM = {
+    0x30, 0x03, 0x0C, 0x0F, 0x3F, 0x33, 0xC0, 0x3C, 0xC3, 0xFF, 0xFC, 0xCC, 0xF0,
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include <stdint.h>
+#include "../FontCompact.h"
+#include "../FontInfo.h"
+
+static constexpr uint8_t DIGITS_10x16_PACKED_FLAGS = 0x12;               // versione 1, compresso
+static constexpr uint16_t DIGITS_10x16_PACKED_FIRST_CODEPOINT = 32;
+static constexpr uint16_t DIGITS_10x16_PACKED_LAST_CODEPOINT = 58;
+static constexpr uint8_t DIGITS_10x16_PACKED_GLYPH_HEIGHT = 16;
+static constexpr uint8_t DIGITS_10x16_PACKED_GLYPH_WIDTH = 10;
+static constexpr uint8_t DIGITS_10x16_PACKED_GLYPH_SPACING = 2;
+
+extern const uint8_t DIGITS_10x16_PACKED_DATA[] FONT_PROGMEM;
+extern const uint16_t DIGITS_10x16_PACKED_INDEX[] FONT_PROGMEM;
+extern const uint8_t DIGITS_10x16_PACKED_DICT[] FONT_PROGMEM;
+
+static constexpr pcd8544::FontInfo DIGITS_10x16_PACKED {
+    DIGITS_10x16_PACKED_FLAGS,
+    DIGITS_10x16_PACKED_FIRST_CODEPOINT,
+    DIGITS_10x16_PACKED_LAST_CODEPOINT,
+    DIGITS_10x16_PACKED_GLYPH_HEIGHT,
+    DIGITS_10x16_PACKED_GLYPH_WIDTH,
+    DIGITS_10x16_PACKED_GLYPH_SPACING,
+    DIGITS_10x16_PACKED_DATA,
+    DIGITS_10x16_PACKED_INDEX,
+    DIGITS_10x16_PACKED_DICT,
+    nullptr,
+    0
+};
@@ -1,8 +1,9 @@
 #pragma once
 #include <stdint.h>
 #include "../FontCompact.h"
+#include "../FontInfo.h"
 
-const uint8_t MONO_5x7_DATA[] FONT_PROGMEM = {
+constexpr uint8_t MONO_5x7_DATA[] FONT_PROGMEM = {
     0x00, 0x00, 0x00, 0x00, 0x00,   // space
     0x00, 0x00, 0x5F, 0x00, 0x00,   // !
     0x00, 0x07, 0x00, 0x07, 0x00,   // "
@@ -98,4 +99,24 @@ const uint8_t MONO_5x7_DATA[] FONT_PROGMEM = {
     0x00, 0x00, 0x7f, 0x00, 0x00,   // |
     0x00, 0x41, 0x36, 0x08, 0x00,   // }
     0x10, 0x08, 0x08, 0x10, 0x08,   // ~
+    // Lettere accentate e simboli fuori dal range principale (vedi MONO_5x7_RANGES)
+    0x00, 0x06, 0x09, 0x09, 0x06,   // ° (U+00B0)
+    0xfc, 0x40, 0x40, 0x20, 0x7c,   // µ (U+00B5)
+    0x20, 0x55, 0x56, 0x54, 0x78,   // à (U+00E0)
+    0x38, 0x55, 0x56, 0x54, 0x18,   // è (U+00E8)
+    0x38, 0x54, 0x56, 0x55, 0x18,   // é (U+00E9)
+    0x00, 0x49, 0x7a, 0x40, 0x00,   // ì (U+00EC)
+    0x38, 0x45, 0x46, 0x44, 0x38,   // ò (U+00F2)
+    0x3c, 0x41, 0x42, 0x20, 0x7c,   // ù (U+00F9)
+};
+
+// Codepoint dei glyph successivi a '~': {primo, ultimo, indice del glyph}
+constexpr pcd8544::CodeRange MONO_5x7_RANGES[] FONT_PROGMEM = {
+    {0x00B0, 0x00B0, 95},   // °
+    {0x00B5, 0x00B5, 96},   // µ
+    {0x00E0, 0x00E0, 97},   // à
+    {0x00E8, 0x00E9, 98},   // è é
+    {0x00EC, 0x00EC, 100},  // ì
+    {0x00F2, 0x00F2, 101},  // ò
+    {0x00F9, 0x00F9, 102},  // ù
 };
\ No newline at end of file
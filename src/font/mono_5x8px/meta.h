@@ -3,7 +3,7 @@
 #include "../FontCompact.h"
 #include "../FontInfo.h"
 
-static constexpr uint8_t FLAGS = 0x10;
+static constexpr uint8_t FLAGS = 0x14;              // versione 1, range di codepoint aggiuntivi
 static constexpr uint16_t FIRST_CODEPOINT = 32;
 static constexpr uint16_t LAST_CODEPOINT = 126;
 static constexpr uint8_t GLYPH_HEIGHT = 8;
@@ -11,6 +11,7 @@ static constexpr uint8_t GLYPH_WIDTH = 5;
 static constexpr uint8_t GLYPH_SPACING = 1;
 
 extern const uint8_t MONO_5x7_DATA[] FONT_PROGMEM;
+extern const pcd8544::CodeRange MONO_5x7_RANGES[] FONT_PROGMEM;
 
 static constexpr pcd8544::FontInfo MONO_5x7 {
     FLAGS,
@@ -19,5 +20,9 @@ static constexpr pcd8544::FontInfo MONO_5x7 {
     GLYPH_HEIGHT,
     GLYPH_WIDTH,
     GLYPH_SPACING,
-    MONO_5x7_DATA
+    MONO_5x7_DATA,
+    nullptr,
+    nullptr,
+    MONO_5x7_RANGES,
+    7
 };
\ No newline at end of file
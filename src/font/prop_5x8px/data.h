@@ -0,0 +1,137 @@
+#pragma once
+#include <stdint.h>
+#include "../FontCompact.h"
+#include "../FontInfo.h"
+
+// Generato da mono_5x8px eliminando le colonne vuote a sinistra e a destra di ogni glyph
+
+constexpr uint8_t PROP_5x8_DATA[] FONT_PROGMEM = {
+    0x00, 0x00,                     // space
+    0x5F,                           // !
+    0x07, 0x00, 0x07,               // "
+    0x14, 0x7F, 0x14, 0x7F, 0x14,   // #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,   // $
+    0x23, 0x13, 0x08, 0x34, 0x32,   // %
+    0x36, 0x49, 0x55, 0x22, 0x50,   // &
+    0x07,                           // '
+    0x1C, 0x22, 0x41,               // (
+    0x41, 0x22, 0x1C,               // )
+    0x14, 0x08, 0x3E, 0x08, 0x14,   // *
+    0x08, 0x08, 0x3E, 0x08, 0x08,   // +
+    0x50, 0x30,                     // ,
+    0x08, 0x08, 0x08, 0x08, 0x08,   // -
+    0x60, 0x60,                     // .
+    0x20, 0x10, 0x08, 0x04, 0x02,   // /
+    0x3E, 0x51, 0x49, 0x45, 0x3E,   // 0
+    0x42, 0x7F, 0x40,               // 1
+    0x42, 0x61, 0x51, 0x49, 0x46,   // 2
+    0x21, 0x41, 0x45, 0x4B, 0x31,   // 3
+    0x18, 0x14, 0x12, 0x7F, 0x10,   // 4
+    0x27, 0x45, 0x45, 0x45, 0x39,   // 5
+    0x3C, 0x4A, 0x49, 0x49, 0x30,   // 6
+    0x03, 0x01, 0x71, 0x09, 0x07,   // 7
+    0x36, 0x49, 0x49, 0x49, 0x36,   // 8
+    0x06, 0x49, 0x49, 0x29, 0x1E,   // 9
+    0x36, 0x36,                     // :
+    0x56, 0x36,                     // ;
+    0x08, 0x14, 0x22, 0x41,         // <
+    0x14, 0x14, 0x14, 0x14, 0x14,   // =
+    0x41, 0x22, 0x14, 0x08,         // >
+    0x02, 0x01, 0x51, 0x09, 0x06,   // ?
+    0x32, 0x49, 0x79, 0x41, 0x3E,   // @
+    0x7C, 0x12, 0x11, 0x12, 0x7C,   // A
+    0x7F, 0x49, 0x49, 0x49, 0x36,   // B
+    0x3E, 0x41, 0x41, 0x41, 0x22,   // C
+    0x7F, 0x41, 0x41, 0x22, 0x1C,   // D
+    0x7F, 0x49, 0x49, 0x49, 0x49,   // E
+    0x7F, 0x09, 0x09, 0x09, 0x09,   // F
+    0x3E, 0x41, 0x49, 0x49, 0x3A,   // G
+    0x7F, 0x08, 0x08, 0x08, 0x7F,   // H
+    0x41, 0x7F, 0x41,               // I
+    0x20, 0x40, 0x41, 0x3F, 0x01,   // J
+    0x7F, 0x08, 0x14, 0x22, 0x41,   // K
+    0x7F, 0x40, 0x40, 0x40, 0x40,   // L
+    0x7F, 0x02, 0x04, 0x02, 0x7F,   // M
+    0x7F, 0x04, 0x08, 0x10, 0x7F,   // N
+    0x3E, 0x41, 0x41, 0x41, 0x3E,   // O
+    0x7F, 0x09, 0x09, 0x09, 0x06,   // P
+    0x3E, 0x41, 0x51, 0x21, 0x5E,   // Q
+    0x7F, 0x09, 0x19, 0x29, 0x46,   // R
+    0x26, 0x49, 0x49, 0x49, 0x32,   // S
+    0x01, 0x01, 0x7F, 0x01, 0x01,   // T
+    0x3F, 0x40, 0x40, 0x40, 0x3F,   // U
+    0x1F, 0x20, 0x40, 0x20, 0x1F,   // V
+    0x3F, 0x40, 0x38, 0x40, 0x3F,   // W
+    0x63, 0x14, 0x08, 0x14, 0x63,   // X
+    0x07, 0x08, 0x70, 0x08, 0x07,   // Y
+    0x61, 0x51, 0x49, 0x45, 0x43,   // Z
+    0x7F, 0x41, 0x41,               // [
+    0x02, 0x04, 0x08, 0x10, 0x20,   // "\"
+    0x41, 0x41, 0x7F,               // ]
+    0x04, 0x02, 0x01, 0x02, 0x04,   // ^
+    0x40, 0x40, 0x40, 0x40, 0x40,   // _
+    0x01, 0x02, 0x04,               // `
+    0x20, 0x54, 0x54, 0x54, 0x78,   // a
+    0x7F, 0x48, 0x44, 0x44, 0x38,   // b
+    0x38, 0x44, 0x44, 0x44, 0x20,   // c
+    0x38, 0x44, 0x44, 0x48, 0x7F,   // d
+    0x38, 0x54, 0x54, 0x54, 0x18,   // e
+    0x08, 0x7E, 0x09, 0x01, 0x02,   // f
+    0x08, 0x54, 0x54, 0x54, 0x3C,   // g
+    0x7F, 0x08, 0x04, 0x04, 0x78,   // h
+    0x48, 0x7D, 0x40,               // i
+    0x20, 0x40, 0x44, 0x3D,         // j
+    0x7F, 0x10, 0x28, 0x44,         // k
+    0x41, 0x7F, 0x40,               // l
+    0x7C, 0x04, 0x08, 0x04, 0x78,   // m
+    0x7C, 0x08, 0x04, 0x04, 0x78,   // n
+    0x38, 0x44, 0x44, 0x44, 0x38,   // o
+    0x7C, 0x14, 0x14, 0x14, 0x08,   // p
+    0x08, 0x14, 0x14, 0x18, 0x7C,   // q
+    0x7C, 0x08, 0x04, 0x04, 0x08,   // r
+    0x48, 0x54, 0x54, 0x54, 0x20,   // s
+    0x04, 0x3F, 0x44, 0x40, 0x20,   // t
+    0x3C, 0x40, 0x40, 0x20, 0x7C,   // u
+    0x1C, 0x20, 0x40, 0x20, 0x1C,   // v
+    0x3C, 0x40, 0x30, 0x40, 0x3C,   // w
+    0x44, 0x28, 0x10, 0x28, 0x44,   // x
+    0x0C, 0x50, 0x50, 0x50, 0x3C,   // y
+    0x44, 0x64, 0x54, 0x4C, 0x44,   // z
+    0x08, 0x36, 0x41,               // {
+    0x7F,                           // |
+    0x41, 0x36, 0x08,               // }
+    0x10, 0x08, 0x08, 0x10, 0x08,   // ~
+    // Lettere accentate e simboli fuori dal range principale (vedi PROP_5x8_RANGES)
+    0x06, 0x09, 0x09, 0x06,       // °
+    0xFC, 0x40, 0x40, 0x20, 0x7C, // µ
+    0x20, 0x55, 0x56, 0x54, 0x78, // à
+    0x38, 0x55, 0x56, 0x54, 0x18, // è
+    0x38, 0x54, 0x56, 0x55, 0x18, // é
+    0x49, 0x7A, 0x40,             // ì
+    0x38, 0x45, 0x46, 0x44, 0x38, // ò
+    0x3C, 0x41, 0x42, 0x20, 0x7C, // ù
+};
+
+// Offset di ogni glyph in PROP_5x8_DATA; la larghezza del glyph i è OFFSETS[i + 1] - OFFSETS[i]
+constexpr uint16_t PROP_5x8_OFFSETS[] FONT_PROGMEM = {
+    0, 2, 3, 6, 11, 16, 21, 26, 27, 30, 33, 38,
+    43, 45, 50, 52, 57, 62, 65, 70, 75, 80, 85, 90,
+    95, 100, 105, 107, 109, 113, 118, 122, 127, 132, 137, 142,
+    147, 152, 157, 162, 167, 172, 175, 180, 185, 190, 195, 200,
+    205, 210, 215, 220, 225, 230, 235, 240, 245, 250, 255, 260,
+    263, 268, 271, 276, 281, 284, 289, 294, 299, 304, 309, 314,
+    319, 324, 327, 331, 335, 338, 343, 348, 353, 358, 363, 368,
+    373, 378, 383, 388, 393, 398, 403, 408, 411, 412, 415, 420,
+    424, 429, 434, 439, 444, 447, 452, 457,
+};
+
+// Codepoint dei glyph successivi a '~': {primo, ultimo, indice del glyph}
+constexpr pcd8544::CodeRange PROP_5x8_RANGES[] FONT_PROGMEM = {
+    {0x00B0, 0x00B0, 95},   // °
+    {0x00B5, 0x00B5, 96},   // µ
+    {0x00E0, 0x00E0, 97},   // à
+    {0x00E8, 0x00E9, 98},   // è é
+    {0x00EC, 0x00EC, 100},  // ì
+    {0x00F2, 0x00F2, 101},  // ò
+    {0x00F9, 0x00F9, 102},  // ù
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include <stdint.h>
+#include "../FontCompact.h"
+#include "../FontInfo.h"
+
+static constexpr uint8_t PROP_5x8_FLAGS = 0x15;             // versione 1, larghezza variabile, range aggiuntivi
+static constexpr uint16_t PROP_5x8_FIRST_CODEPOINT = 32;
+static constexpr uint16_t PROP_5x8_LAST_CODEPOINT = 126;
+static constexpr uint8_t PROP_5x8_GLYPH_HEIGHT = 8;
+static constexpr uint8_t PROP_5x8_GLYPH_WIDTH = 0;
+static constexpr uint8_t PROP_5x8_GLYPH_SPACING = 1;
+
+extern const uint8_t PROP_5x8_DATA[] FONT_PROGMEM;
+extern const uint16_t PROP_5x8_OFFSETS[] FONT_PROGMEM;
+extern const pcd8544::CodeRange PROP_5x8_RANGES[] FONT_PROGMEM;
+
+static constexpr pcd8544::FontInfo PROP_5x8 {
+    PROP_5x8_FLAGS,
+    PROP_5x8_FIRST_CODEPOINT,
+    PROP_5x8_LAST_CODEPOINT,
+    PROP_5x8_GLYPH_HEIGHT,
+    PROP_5x8_GLYPH_WIDTH,
+    PROP_5x8_GLYPH_SPACING,
+    PROP_5x8_DATA,
+    PROP_5x8_OFFSETS,
+    nullptr,
+    PROP_5x8_RANGES,
+    7
+};
@@ -0,0 +1,546 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include "../font/FontInfo.h"
+#include "../font/Glyph.h"
+#include "../font/Number.h"
+#include "../font/StaticText.h"
+#include "../font/Utf8.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+  #define PCD8544_ASYNC_TASK 1
+#elif !defined(ARDUINO)
+  // Host (extras/host): un std::thread al posto del task
+  #include <thread>
+  #include <mutex>
+  #include <condition_variable>
+  #define PCD8544_ASYNC_THREAD 1
+#endif
+
+/*
+ * ** AsyncDisplay **
+ * Coda di disegno asincrona: le chiamate (stessi nomi del driver) scrivono operazioni compatte in una coda
+ * circolare di N byte senza lock (un produttore, un consumatore) e ritornano subito; un consumatore le
+ * esegue sul display, tutte quelle disponibili in un unico frame (CS basso una volta).
+ *  - ESP32: task FreeRTOS fissato su un core (di default lo 0, il loop di Arduino gira sull'1)
+ *  - host: std::thread (compilare con -pthread)
+ *  - altri core: nessun task, le operazioni vengono eseguite da run() o da flush() (rendering differito)
+ *
+ *      static pcd8544::AsyncDisplay<PCD8544> screen(lcd);
+ *      screen.begin();                                 // dopo lcd.begin()
+ *      screen.setCursor(0, 2);
+ *      screen.print("T ");
+ *      screen.print(pcd8544::Number(t10, {1, 5}));     // unita alla print precedente: una sola operazione
+ *      screen.flush();                                 // attende che tutto sia sul display (opzionale)
+ *
+ * Coalescenza: dentro un frame (beginFrame/endFrame) le operazioni vengono pubblicate solo a endFrame(), e nel
+ * frattempo print() consecutive si uniscono in una sola, drawText() contigui sulla stessa riga (x successivo =
+ * fine del precedente) pure, e setCursor() consecutivi si riducono all'ultimo. Fuori da un frame ogni chiamata
+ * viene pubblicata subito.
+ * Contropressione: con la coda piena il produttore attende (BLOCK, default) oppure scarta l'operazione (DROP,
+ * per i loop che non possono fermarsi); fence() e flush() attendono sempre.
+ *
+ * Dopo begin() il display appartiene al consumatore: non chiamare più i metodi di lcd direttamente.
+ * I dati passati per puntatore (font, bitmap, StaticText) devono restare validi finché l'operazione non è
+ * stata eseguita (flush() o done()); le stringhe invece vengono copiate nella coda.
+ */
+namespace pcd8544 {
+
+enum class Backpressure : uint8_t { BLOCK, DROP };
+
+struct AsyncStats {
+    uint32_t ops = 0;       // operazioni pubblicate
+    uint32_t merged = 0;    // chiamate unite all'operazione precedente
+    uint32_t dropped = 0;   // operazioni scartate (Backpressure::DROP)
+    uint32_t stalls = 0;    // attese del produttore per coda piena
+};
+
+template <class Display, uint16_t N = 1024>
+class AsyncDisplay {
+    static_assert(N >= 512 && N <= 32768 && (N & (N - 1)) == 0, "AsyncDisplay: N deve essere una potenza di 2 (512..32768)");
+public:
+    explicit AsyncDisplay (Display& lcd) : _lcd(lcd) {}
+    ~AsyncDisplay () { end(); }
+    AsyncDisplay (const AsyncDisplay&) = delete;
+    AsyncDisplay& operator= (const AsyncDisplay&) = delete;
+
+    /*
+     *  Function: begin
+     *  Desc: Avvia il consumatore (task su core, con priorità e stack indicati; sull'host un thread). Font e
+     *      scala correnti del display diventano quelli della coda.
+     */
+    void begin (uint8_t core = 0, uint8_t priority = 2, uint16_t stackBytes = 3072) {
+        _font = _lcd.getFont();
+        _scale = _lcd.getTextScale();
+        #if PCD8544_ASYNC_TASK
+            if (!_task) {
+                _stop = false;
+                _stopped = false;
+                xTaskCreatePinnedToCore(taskMain, "pcd8544", stackBytes, this, priority, &_task, core);
+            }
+        #elif PCD8544_ASYNC_THREAD
+            (void)core; (void)priority; (void)stackBytes;
+            if (!_thread.joinable()) {
+                _stop = false;
+                _thread = std::thread([this] { threadMain(); });
+            }
+        #else
+            (void)core; (void)priority; (void)stackBytes;
+        #endif
+    }
+    // Esegue le operazioni in coda e ferma il consumatore: il display torna utilizzabile direttamente
+    void end () {
+        if (!running()) return;
+        flush();
+        #if PCD8544_ASYNC_TASK
+            // il task esce dal suo ciclo da solo: non viene mai interrotto con il bus SPI occupato
+            store(_stop, true);
+            xTaskNotifyGive(_task);
+            while (!load(_stopped)) vTaskDelay(1);
+            _task = nullptr;
+        #elif PCD8544_ASYNC_THREAD
+            {
+                std::lock_guard<std::mutex> g(_m);
+                _stop = true;
+            }
+            _cv.notify_one();
+            _thread.join();
+        #endif
+    }
+
+    inline void setBackpressure (Backpressure b) { _policy = b; }
+
+    // Frame: le operazioni vengono unite dove possibile e pubblicate insieme a endFrame()
+    inline void beginFrame () { _frameDepth++; }
+    inline void endFrame () {
+        if (!_frameDepth || --_frameDepth) return;
+        publish();
+    }
+    class FrameScope {
+    public:
+        explicit FrameScope (AsyncDisplay& d) : _d(d) { _d.beginFrame(); }
+        ~FrameScope () { _d.endFrame(); }
+        FrameScope (const FrameScope&) = delete;
+        FrameScope& operator= (const FrameScope&) = delete;
+    private:
+        AsyncDisplay& _d;
+    };
+
+    /*
+     *  Function: fence
+     *  Desc: Pubblica le operazioni in attesa e ritorna un numero che done() riconosce quando tutte le
+     *      operazioni precedenti sono state eseguite. Non viene mai scartata.
+     */
+    uint32_t fence () {
+        if (!open(Op::FENCE, 0, true)) return _fences;
+        commit(false);
+        publish();
+        return ++_fences;
+    }
+    inline bool done (uint32_t ticket) const { return (int32_t)(load(_fencesDone) - ticket) >= 0; }
+    // Attende che tutte le operazioni accodate siano sul display
+    void flush () {
+        const uint32_t t = fence();
+        while (!done(t)) wait();
+    }
+
+    /*
+     *  Function: run
+     *  Desc: Consumatore: esegue tutte le operazioni pubblicate, in un unico frame del display. Ritorna il
+     *      numero di operazioni eseguite. La chiama il task; senza task va chiamata nel loop.
+     */
+    uint16_t run () {
+        uint16_t t = load(_tail);
+        uint16_t h = load(_head);
+        uint16_t count = 0;
+        bool frame = false;
+        while (t != h) {
+            const Op op = (Op)at(t);
+            const uint8_t len = at(t + 1);
+            if (op != Op::FENCE) {
+                if (!frame) { _lcd.beginFrame(); frame = true; }
+                execute(op, (uint16_t)(t + 2), len);
+            }
+            // la fence chiude il frame prima di essere segnalata: dopo done() il bus è libero
+            else if (frame) { _lcd.endFrame(); frame = false; }
+            t = (uint16_t)(t + 2 + len);
+            store(_tail, t);
+            if (op == Op::FENCE) store(_fencesDone, (uint32_t)(load(_fencesDone) + 1));
+            count++;
+            if (t == h) h = load(_head);
+        }
+        if (frame) _lcd.endFrame();
+        return count;
+    }
+
+    // ### Disegno (vedi i metodi omonimi di PCD8544)
+    inline void clear () { if (open(Op::CLEAR, 0)) commit(); }
+    void setCursor (uint8_t x, uint8_t page) {
+        if (staged(Op::CURSOR)) { put(_last + 2, x); put(_last + 3, page); _stats.merged++; return; }
+        if (!open(Op::CURSOR, 2)) return;
+        put(x); put(page);
+        commit();
+    }
+    void setFont (const FontInfo& f) {
+        if (!f.isValid() || !open(Op::FONT, sizeof(const FontInfo*))) return;
+        const FontInfo* p = &f;
+        putBytes(&p, sizeof(p));
+        commit();
+        _font = f;
+    }
+    void setTextScale (uint8_t scale) {
+        scale = scale < 1 ? 1 : (scale > 4 ? 4 : scale);
+        if (!open(Op::SCALE, 1)) return;
+        put(scale);
+        commit();
+        _scale = scale;
+    }
+    inline void print (const char* str, const bool highlighted = false) {
+        if (str) text(Op::PRINT, 0, 0, str, strlen(str), highlighted);
+    }
+    void print (char c, const bool highlighted = false) {
+        // un byte non ASCII è Latin-1 (come PCD8544::print(char)): in coda va in UTF-8
+        const uint8_t b = (uint8_t)c;
+        const char buf[2] = {(char)(0xC0 | (b >> 6)), (char)(0x80 | (b & 0x3F))};
+        if (b < 0x80) text(Op::PRINT, 0, 0, &c, 1, highlighted);
+        else text(Op::PRINT, 0, 0, buf, 2, highlighted);
+    }
+    inline void print (int value, const bool highlighted = false) { print(Number(value), highlighted); }
+    inline void print (unsigned int value, const bool highlighted = false) { print(Number(value), highlighted); }
+    inline void print (long value, const bool highlighted = false) { print(Number(value), highlighted); }
+    inline void print (unsigned long value, const bool highlighted = false) { print(Number(value), highlighted); }
+    // I numeri vengono formattati subito: in coda sono testo, unibile alle print() vicine
+    void print (Number number, const bool highlighted = false) {
+        char buf[32];
+        uint8_t n = 0;
+        while (number.more() && n < sizeof(buf)) buf[n++] = (char)number.next();
+        text(Op::PRINT, 0, 0, buf, n, highlighted);
+    }
+    inline void drawText (int16_t x, int16_t y, const char* str, const bool highlighted = false) {
+        if (str) text(Op::TEXT, x, y, str, strlen(str), highlighted);
+    }
+    template <uint16_t W, uint8_t P>
+    inline void print (const StaticText<W, P>& t, const bool highlighted = false) {
+        call(&printStaticThunk<W, P>, &t, 0, 0, highlighted);
+    }
+    template <uint16_t W, uint8_t P>
+    inline void drawStatic (uint8_t x, uint8_t page, const StaticText<W, P>& t, const bool highlighted = false) {
+        call(&drawStaticThunk<W, P>, &t, x, page, highlighted);
+    }
+    void fill (uint8_t x, uint8_t page, uint8_t width, uint8_t pages, uint8_t value) {
+        if (!open(Op::FILL, 5)) return;
+        put(x); put(page); put(width); put(pages); put(value);
+        commit();
+    }
+    inline void fillRow (uint8_t row) { call(&fillRowThunk, nullptr, row); }
+    void drawStraightLine (uint8_t c1, uint8_t c2, uint8_t oc, bool horizontal, uint8_t borderWidth) {
+        if (!open(Op::LINE, 5)) return;
+        put(c1); put(c2); put(oc); put(horizontal); put(borderWidth);
+        commit();
+    }
+    void drawBitmap (int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t* bmp, const bool progmem = false) {
+        if (!open(Op::BITMAP, (uint8_t)(7 + sizeof(bmp)))) return;
+        putBytes(&x, 2); putBytes(&y, 2); put(width); put(height); put(progmem);
+        putBytes(&bmp, sizeof(bmp));
+        commit();
+    }
+    inline void setContrast (uint16_t level) { call(&contrastThunk, nullptr, level); }
+    inline void setBias (uint16_t level) { call(&biasThunk, nullptr, level); }
+    inline void setTC (uint16_t level) { call(&tcThunk, nullptr, level); }
+    inline void backlightLevel (uint16_t level) { call(&backlightThunk, nullptr, level); }
+
+    inline const AsyncStats& getStats () const { return _stats; }
+    inline void resetStats () { _stats = AsyncStats(); }
+
+private:
+    enum class Op : uint8_t { FENCE, CLEAR, CURSOR, FONT, SCALE, PRINT, TEXT, FILL, LINE, BITMAP, CALL };
+    // Operazione generica: funzione eseguita dal consumatore con un puntatore e due parametri
+    typedef void (*Thunk) (Display&, const void*, uint16_t a, uint16_t b);
+    static constexpr uint8_t MAX_PAYLOAD = 255;
+    static constexpr uint8_t TEXT_HEADER = 5;   // x, y (int16), highlighted
+
+    Display& _lcd;
+    uint8_t _ring[N];
+    // Indici liberi (modulo 65536): [_tail, _head) pubblicati, [_head, _stage) in preparazione
+    volatile uint16_t _head = 0;        // scritto solo dal produttore
+    volatile uint16_t _tail = 0;        // scritto solo dal consumatore
+    volatile uint32_t _fencesDone = 0;  // scritto solo dal consumatore
+    uint16_t _stage = 0;
+    uint16_t _last = 0;                 // intestazione dell'ultima operazione in preparazione
+    bool _lastValid = false;            // _last non ancora pubblicata: si può ancora modificare
+    int16_t _lastEnd = 0;               // TEXT: x della fine del testo
+    uint32_t _fences = 0;
+    uint8_t _frameDepth = 0;
+    Backpressure _policy = Backpressure::BLOCK;
+    FontInfo _font {0, 0, 0, 0, 0, 0, nullptr, nullptr, nullptr, nullptr, 0};     // font e scala che il consumatore avrà a quel punto della coda
+    uint8_t _scale = 1;
+    AsyncStats _stats;
+    #if PCD8544_ASYNC_TASK
+        TaskHandle_t _task = nullptr;
+        volatile bool _stop = false;
+        volatile bool _stopped = false;
+    #elif PCD8544_ASYNC_THREAD
+        std::thread _thread;
+        std::mutex _m;
+        std::condition_variable _cv;
+        bool _stop = false;
+    #endif
+
+    // Accessi agli indici condivisi: acquire/release solo se produttore e consumatore sono concorrenti
+    template <class T>
+    static inline T load (const volatile T& v) {
+        #if PCD8544_ASYNC_TASK || PCD8544_ASYNC_THREAD
+            return __atomic_load_n(&v, __ATOMIC_ACQUIRE);
+        #else
+            return v;
+        #endif
+    }
+    template <class T>
+    static inline void store (volatile T& v, T value) {
+        #if PCD8544_ASYNC_TASK || PCD8544_ASYNC_THREAD
+            __atomic_store_n(&v, value, __ATOMIC_RELEASE);
+        #else
+            v = value;
+        #endif
+    }
+
+    inline bool running () const {
+        #if PCD8544_ASYNC_TASK
+            return _task != nullptr;
+        #elif PCD8544_ASYNC_THREAD
+            return _thread.joinable();
+        #else
+            return false;
+        #endif
+    }
+    inline uint8_t at (uint16_t i) const { return _ring[i & (N - 1)]; }
+    inline void put (uint16_t i, uint8_t b) { _ring[i & (N - 1)] = b; }
+    inline void put (uint8_t b) { _ring[_stage++ & (N - 1)] = b; }
+    inline void putBytes (const void* src, uint8_t n) {
+        const uint8_t* s = (const uint8_t*)src;
+        while (n--) put(*s++);
+    }
+    inline void getBytes (void* dst, uint16_t i, uint8_t n) const {
+        uint8_t* d = (uint8_t*)dst;
+        while (n--) *d++ = at(i++);
+    }
+
+    // Rende visibili al consumatore le operazioni in preparazione
+    void publish () {
+        _lastValid = false;
+        if (_stage == _head) return;
+        store(_head, _stage);
+        wake();
+    }
+    void wake () {
+        #if PCD8544_ASYNC_TASK
+            if (_task) xTaskNotifyGive(_task);
+        #elif PCD8544_ASYNC_THREAD
+            { std::lock_guard<std::mutex> g(_m); }
+            _cv.notify_one();
+        #endif
+    }
+    // Attesa del produttore (spazio in coda o fence)
+    void wait () {
+        #if PCD8544_ASYNC_TASK
+            if (_task) { vTaskDelay(1); return; }
+        #elif PCD8544_ASYNC_THREAD
+            if (_thread.joinable()) { std::this_thread::yield(); return; }
+        #endif
+        run();      // nessun consumatore concorrente: esegue qui
+    }
+
+    /*
+     *  Function: reserve
+     *  Desc: Garantisce n byte liberi dopo _stage. Con la coda piena pubblica ciò che è in preparazione (che
+     *      non si potrà più unire) e attende, oppure con DROP rinuncia.
+     */
+    bool reserve (uint16_t n, bool always = false) {
+        while ((uint16_t)(_stage - load(_tail)) + n > N) {
+            publish();
+            if (_policy == Backpressure::DROP && !always) { _stats.dropped++; return false; }
+            _stats.stalls++;
+            wait();
+        }
+        return true;
+    }
+    // Nuova operazione: intestazione (tipo, lunghezza del contenuto)
+    bool open (Op op, uint8_t len, bool always = false) {
+        if (!reserve((uint16_t)(2 + len), always)) return false;
+        _last = _stage;
+        put((uint8_t)op);
+        put(len);
+        return true;
+    }
+    inline void commit (bool mergeable = true) {
+        _stats.ops++;
+        _lastValid = mergeable;
+        if (!_frameDepth) publish();
+    }
+    inline bool staged (Op op) const { return _lastValid && (Op)at(_last) == op; }
+
+    inline uint16_t width (const char* s, uint8_t n) const {
+        return _font.isValid() ? (uint16_t)(textWidth(_font, s, n) * (_font.pages() == 1 ? _scale : 1)) : 0;
+    }
+
+    /*
+     *  Function: text
+     *  Desc: Accoda un testo (PRINT alla posizione del cursore, TEXT in x, y), in pezzi da al massimo 255 byte
+     *      divisi tra un codepoint e l'altro. Se l'ultima operazione in preparazione è dello stesso tipo e il
+     *      testo la prosegue, i byte le vengono aggiunti.
+     */
+    void text (Op op, int16_t x, int16_t y, const char* s, size_t len, bool highlighted) {
+        const uint8_t header = op == Op::TEXT ? TEXT_HEADER : 1;
+        while (len) {
+            if (staged(op) && at(_last + 2 + header - 1) == (uint8_t)highlighted && continues(op, x, y)) {
+                const uint8_t room = (uint8_t)(MAX_PAYLOAD - at(_last + 1));
+                const uint8_t n = chunk(s, len, room);
+                if (n && reserve(n) && _lastValid) {
+                    putBytes(s, n);
+                    put(_last + 1, (uint8_t)(at(_last + 1) + n));
+                    if (op == Op::TEXT) { x = (int16_t)(x + width(s, n)); _lastEnd = x; }
+                    s += n; len -= n;
+                    _stats.merged++;
+                    continue;
+                }
+                if (n && !_lastValid && _policy == Backpressure::DROP) return;
+            }
+            const uint8_t n = chunk(s, len, (uint8_t)(MAX_PAYLOAD - header));
+            if (!open(op, (uint8_t)(header + n))) return;
+            if (op == Op::TEXT) { putBytes(&x, 2); putBytes(&y, 2); }
+            put((uint8_t)highlighted);
+            putBytes(s, n);
+            commit();
+            if (op == Op::TEXT) { x = (int16_t)(x + width(s, n)); _lastEnd = x; }
+            s += n; len -= n;
+        }
+    }
+    inline bool continues (Op op, int16_t x, int16_t y) const {
+        if (op != Op::TEXT) return true;
+        int16_t ly;
+        getBytes(&ly, (uint16_t)(_last + 4), 2);
+        return ly == y && _lastEnd == x;
+    }
+    // Byte di s (al massimo room) che terminano su un confine di codepoint
+    static inline uint8_t chunk (const char* s, size_t len, uint8_t room) {
+        if (len <= room) return (uint8_t)len;
+        uint8_t n = room;
+        while (n && ((uint8_t)s[n] & 0xC0) == 0x80) n--;
+        return n ? n : room;
+    }
+
+    void call (Thunk fn, const void* p, uint16_t a, uint16_t b = 0) {
+        if (!open(Op::CALL, (uint8_t)(sizeof(fn) + sizeof(p) + 4))) return;
+        putBytes(&fn, sizeof(fn)); putBytes(&p, sizeof(p)); putBytes(&a, 2); putBytes(&b, 2);
+        commit();
+    }
+    static void contrastThunk (Display& d, const void*, uint16_t level, uint16_t) { d.setContrast(level); }
+    static void biasThunk (Display& d, const void*, uint16_t level, uint16_t) { d.setBias(level); }
+    static void tcThunk (Display& d, const void*, uint16_t level, uint16_t) { d.setTC(level); }
+    static void backlightThunk (Display& d, const void*, uint16_t level, uint16_t) { d.backlightLevel(level); }
+    static void fillRowThunk (Display& d, const void*, uint16_t row, uint16_t) { d.fillRow((uint8_t)row); }
+    template <uint16_t W, uint8_t P>
+    static void printStaticThunk (Display& d, const void* t, uint16_t, uint16_t hl) {
+        d.print(*(const StaticText<W, P>*)t, hl != 0);
+    }
+    template <uint16_t W, uint8_t P>
+    static void drawStaticThunk (Display& d, const void* t, uint16_t xy, uint16_t hl) {
+        d.drawStatic((uint8_t)(xy >> 8), (uint8_t)xy, *(const StaticText<W, P>*)t, hl != 0);
+    }
+    template <uint16_t W, uint8_t P>
+    inline void call (Thunk fn, const StaticText<W, P>* t, uint8_t x, uint8_t page, bool hl) {
+        call(fn, (const void*)t, (uint16_t)((x << 8) | page), (uint16_t)hl);
+    }
+
+    // Consumatore: esegue l'operazione con contenuto [i, i + len)
+    void execute (Op op, uint16_t i, uint8_t len) {
+        uint8_t p[MAX_PAYLOAD + 1];
+        getBytes(p, i, len);
+        p[len] = 0;
+        switch (op) {
+        case Op::CLEAR:
+            _lcd.clear();
+            break;
+        case Op::CURSOR:
+            _lcd.setCursor(p[0], p[1]);
+            break;
+        case Op::FONT: {
+            const FontInfo* f;
+            memcpy(&f, p, sizeof(f));
+            _lcd.setFont(*f);
+            break;
+        }
+        case Op::SCALE:
+            _lcd.setTextScale(p[0]);
+            break;
+        case Op::PRINT:
+            _lcd.print((const char*)p + 1, p[0] != 0);
+            break;
+        case Op::TEXT: {
+            int16_t x, y;
+            memcpy(&x, p, 2);
+            memcpy(&y, p + 2, 2);
+            _lcd.drawText(x, y, (const char*)p + TEXT_HEADER, p[4] != 0);
+            break;
+        }
+        case Op::FILL: {
+            const uint8_t v = p[4];
+            _lcd.drawGenerated(p[0], p[1], p[2], p[3], [v](uint8_t, uint8_t) { return v; });
+            break;
+        }
+        case Op::LINE:
+            _lcd.drawStraightLine(p[0], p[1], p[2], p[3] != 0, p[4]);
+            break;
+        case Op::BITMAP: {
+            int16_t x, y;
+            const uint8_t* bmp;
+            memcpy(&x, p, 2);
+            memcpy(&y, p + 2, 2);
+            memcpy(&bmp, p + 7, sizeof(bmp));
+            _lcd.drawBitmap(x, y, p[4], p[5], bmp, p[6] != 0);
+            break;
+        }
+        case Op::CALL: {
+            Thunk fn;
+            const void* ptr;
+            uint16_t a, b;
+            memcpy(&fn, p, sizeof(fn));
+            memcpy(&ptr, p + sizeof(fn), sizeof(ptr));
+            memcpy(&a, p + sizeof(fn) + sizeof(ptr), 2);
+            memcpy(&b, p + sizeof(fn) + sizeof(ptr) + 2, 2);
+            fn(_lcd, ptr, a, b);
+            break;
+        }
+        case Op::FENCE:     // gestita da run()
+            break;
+        }
+    }
+
+    #if PCD8544_ASYNC_TASK
+        static void taskMain (void* arg) {
+            AsyncDisplay* self = (AsyncDisplay*)arg;
+            while (!load(self->_stop)) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                while (self->run()) {}
+            }
+            store(self->_stopped, true);
+            vTaskDelete(nullptr);
+        }
+    #elif PCD8544_ASYNC_THREAD
+        void threadMain () {
+            std::unique_lock<std::mutex> l(_m);
+            while (!_stop) {
+                l.unlock();
+                while (run()) {}
+                l.lock();
+                _cv.wait(l, [this] { return _stop || load(_head) != load(_tail); });
+            }
+            l.unlock();
+            while (run()) {}
+        }
+    #endif
+};
+
+}
@@ -0,0 +1,259 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include "bits.h"
+#include "../font/FontCompact.h"
+#include "../font/FontInfo.h"
+#include "../font/Glyph.h"
+
+/*
+ * ** Canvas **
+ * Buffer in RAM di NPAGES pagine x 84 colonne che rappresenta una striscia del display, a partire dalla
+ * pagina _page0. Le primitive usano coordinate in pixel dello schermo intero (84x48) e vengono ritagliate
+ * sulla striscia: disegnando la stessa scena una volta per ogni posizione della striscia si ottiene l'intero
+ * schermo con soli NPAGES * 84 byte di RAM (vedi PageCanvas).
+ *
+ * A differenza dell'API in streaming del driver, sul canvas le primitive si combinano con il contenuto
+ * già presente tramite BlendOp.
+ */
+namespace pcd8544 {
+
+// Nessun tracciamento delle modifiche (PageCanvas)
+struct NoDirty {
+    static constexpr bool TRACKING = false;
+    inline void mark (uint16_t) {}
+};
+
+template <uint8_t NPAGES, class Dirty = NoDirty>
+class Canvas {
+public:
+    static constexpr uint8_t WIDTH = 84;
+    static constexpr uint8_t HEIGHT = 48;
+    static constexpr uint16_t SIZE = (uint16_t)NPAGES * WIDTH;
+
+    inline void setFont (const FontInfo& f) { _font = f; _fontReady = f.isValid() && !f.isPacked(); }
+    inline void clear (uint8_t value = 0x00) {
+        if (Dirty::TRACKING) {     // costante: il ramo inutile sparisce anche senza if constexpr (C++11)
+            for (uint16_t i = 0; i < SIZE; i++) {
+                if (_buf[i] != value) { _buf[i] = value; _dirty.mark(i); }
+            }
+        } else {
+            memset(_buf, value, SIZE);
+        }
+    }
+
+    inline void drawPixel (int16_t x, int16_t y, BlendOp op = BlendOp::OR) { fillRect(x, y, 1, 1, op); }
+    inline void drawHLine (int16_t x, int16_t y, int16_t w, BlendOp op = BlendOp::OR) { fillRect(x, y, w, 1, op); }
+    inline void drawVLine (int16_t x, int16_t y, int16_t h, BlendOp op = BlendOp::OR) { fillRect(x, y, 1, h, op); }
+    inline void fillRect (int16_t x, int16_t y, int16_t w, int16_t h, BlendOp op = BlendOp::OR) {
+        blend(x, y, w, h, [](int16_t, int16_t) { return (uint8_t)0xFF; }, op);
+    }
+    void drawRect (int16_t x, int16_t y, int16_t w, int16_t h, BlendOp op = BlendOp::OR) {
+        if (w <= 0 || h <= 0) return;
+        drawHLine(x, y, w, op);
+        if (h > 1) drawHLine(x, (int16_t)(y + h - 1), w, op);
+        if (h > 2) {
+            drawVLine(x, (int16_t)(y + 1), (int16_t)(h - 2), op);
+            if (w > 1) drawVLine((int16_t)(x + w - 1), (int16_t)(y + 1), (int16_t)(h - 2), op);
+        }
+    }
+
+    /*
+     *  Function: drawBitmap
+     *  Desc: Immagine nel formato di PCD8544::drawBitmap (ceil(h / 8) righe da w byte), da RAM o flash.
+     */
+    void drawBitmap (int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bmp, bool progmem = false, BlendOp op = BlendOp::OR) {
+        if (!bmp) return;
+        const int16_t srcPages = (int16_t)((h + 7) >> 3);
+        blend(x, y, w, h, [&](int16_t sp, int16_t c) -> uint8_t {
+            if (sp < 0 || sp >= srcPages) return 0;
+            const uint8_t* p = bmp + (uint16_t)sp * w + c;
+            return progmem ? FONT_READ_U8(p) : *p;
+        }, op);
+    }
+
+    /*
+     *  Function: drawText
+     *  Desc: Scrive una stringa UTF-8 con il font impostato (setFont), con il bordo superiore in y (pixel).
+     *      Con BlendOp::COPY anche la spaziatura tra i caratteri sovrascrive lo sfondo.
+     *      Ritorna la x successiva all'ultimo carattere.
+     */
+    int16_t drawText (int16_t x, int16_t y, const char* str, BlendOp op = BlendOp::OR) {
+        if (!str || !_fontReady) return x;
+        const uint8_t pages = _font.pages();
+        const char* end = str + strlen(str);
+        while (str < end && x < WIDTH) {
+            const Glyph g = findGlyph(_font, utf8Next(str, end));
+            const uint8_t adv = (uint8_t)(g.width + _font.gSpacing);
+            blend(x, y, adv, _font.gHeight ? _font.gHeight : 8, [&](int16_t sp, int16_t c) -> uint8_t {
+                return (sp >= 0 && sp < pages && c < g.width) ? g.column((uint8_t)sp, (uint8_t)c) : 0;
+            }, op);
+            x = (int16_t)(x + adv);
+        }
+        return x;
+    }
+
+    inline const uint8_t* data () const { return _buf; }
+    inline uint8_t* data () { return _buf; }
+    inline uint8_t pageOrigin () const { return _page0; }
+
+protected:
+    uint8_t _buf[SIZE];
+    uint8_t _page0 = 0;     // prima pagina del display contenuta nel buffer
+    FontInfo _font {0,0,0,0,0,0,nullptr,nullptr,nullptr,nullptr,0};
+    bool _fontReady = false;
+    Dirty _dirty;   // byte modificati (solo se Dirty::TRACKING)
+
+    /*
+     *  Function: blend
+     *  Desc: Combina con op un rettangolo sorgente di w x h pixel in (x, y). src(sp, c) ritorna il byte della
+     *      pagina sp, colonna c della sorgente (0 fuori range). Ritaglia su schermo e striscia corrente.
+     */
+    template <class S>
+    void blend (int16_t x, int16_t y, int16_t w, int16_t h, S&& src, BlendOp op) {
+        if (w <= 0 || h <= 0) return;
+        const int16_t x0 = x < 0 ? 0 : x;
+        const int16_t x1 = (int16_t)(x + w) > WIDTH ? WIDTH : (int16_t)(x + w);
+        const int16_t stripTop = (int16_t)_page0 * 8;
+        const int16_t stripBottom = (int16_t)(stripTop + NPAGES * 8) > HEIGHT ? HEIGHT : (int16_t)(stripTop + NPAGES * 8);
+        const int16_t y0 = y < stripTop ? stripTop : y;
+        const int16_t y1 = (int16_t)(y + h) > stripBottom ? stripBottom : (int16_t)(y + h);
+        if (x0 >= x1 || y0 >= y1) return;
+
+        for (int16_t page = (int16_t)(y0 >> 3); page <= (int16_t)((y1 - 1) >> 3); page++) {
+            const int16_t off = (int16_t)(page * 8 - y);
+            const uint8_t mask = bits::rowMask((int16_t)-off, h);
+            const uint16_t rowStart = (uint16_t)(page - _page0) * WIDTH;
+            for (int16_t c = x0; c < x1; c++) {
+                const int16_t sc = (int16_t)(c - x);
+                const uint8_t v = (uint8_t)(bits::composeColumn([&](int16_t sp) { return src(sp, sc); }, off) & mask);
+                const uint8_t d = _buf[rowStart + c];
+                const uint8_t n = bits::blend(d, v, mask, op);
+                if (n != d) {
+                    _buf[rowStart + c] = n;
+                    _dirty.mark((uint16_t)(rowStart + c));
+                }
+            }
+        }
+    }
+};
+
+/*
+ *  PageCanvas: rendering a pagine ("picture loop") con un solo buffer da 84 byte.
+ *  La scena viene ridisegnata una volta per ogni pagina; le primitive scrivono solo la parte che cade
+ *  nella pagina corrente, che viene poi inviata al display in un unico burst.
+ *
+ *      canvas.firstPage();
+ *      do {
+ *          canvas.fillRect(10, 5, 30, 20);
+ *          canvas.drawText(14, 12, "XOR", BlendOp::XOR);
+ *      } while (canvas.nextPage(lcd));
+ */
+class PageCanvas : public Canvas<1> {
+public:
+    inline void firstPage () {
+        _page0 = 0;
+        clear();
+    }
+    // Invia la pagina corrente e passa alla successiva. Ritorna false dopo l'ultima pagina.
+    template <class Display>
+    bool nextPage (Display& lcd) {
+        lcd.writeRow(_page0, _buf);
+        if (++_page0 >= HEIGHT / 8) {
+            _page0 = 0;
+            return false;
+        }
+        clear();
+        return true;
+    }
+    inline uint8_t page () const { return _page0; }
+};
+
+
+/*
+ *  DirtyBits: un bit per ogni byte del buffer, acceso quando il byte cambia valore.
+ */
+template <uint16_t SIZE>
+struct DirtyBits {
+    static constexpr bool TRACKING = true;
+    uint8_t bits[(SIZE + 7) / 8] = {0};
+    inline void mark (uint16_t i) { bits[i >> 3] |= (uint8_t)(1 << (i & 7)); }
+    inline bool test (uint16_t i) const { return bits[i >> 3] & (1 << (i & 7)); }
+    inline void clearAll () { memset(bits, 0, sizeof(bits)); }
+    inline void setAll () { memset(bits, 0xFF, sizeof(bits)); }
+};
+
+/*
+ *  Distanza massima (in byte non modificati) tra due zone modificate che flush() invia insieme invece di
+ *  riposizionare il cursore. Riposizionare costa fino a 2 byte di comando più le commutazioni di D/C.
+ */
+#ifndef PCD8544_FLUSH_MERGE_GAP
+#define PCD8544_FLUSH_MERGE_GAP 3
+#endif
+
+/*
+ *  FrameBuffer: copia completa dello schermo in RAM (504 byte + 63 byte di bit "dirty").
+ *  Si disegna liberamente con le primitive del canvas, poi flush() invia al display solo i byte cambiati.
+ *
+ *  La DDRAM viene vista come un'unica sequenza di 504 byte (page * 84 + x), nell'ordine dell'auto-incremento
+ *  orizzontale: una zona che finisce a fine pagina prosegue sulla pagina successiva senza comandi.
+ *  Zone separate da al massimo PCD8544_FLUSH_MERGE_GAP byte invariati vengono unite in un unico burst.
+ */
+class FrameBuffer : public Canvas<6, DirtyBits<(uint16_t)6 * 84>> {
+public:
+    struct FlushStats {
+        uint16_t dataBytes = 0;     // byte dati inviati
+        uint8_t spans = 0;          // burst (ognuno preceduto da al massimo 2 comandi di posizionamento)
+    };
+
+    // Il contenuto del display non è noto: il primo flush() invia tutto lo schermo
+    FrameBuffer () {
+        memset(_buf, 0, SIZE);
+        _dirty.setAll();
+    }
+
+    // Forza l'invio completo al prossimo flush() (es. dopo clear() o begin() del display)
+    inline void invalidate () { _dirty.setAll(); }
+    inline bool isDirty () const {
+        for (uint8_t b : _dirty.bits) if (b) return true;
+        return false;
+    }
+
+    /*
+     *  Function: flush
+     *  Desc: Invia le zone modificate dall'ultimo flush, in un'unica transazione SPI.
+     *      Ritorna (e memorizza in lastFlush()) i byte inviati; uno schermo completo sono 504 byte dati.
+     */
+    template <class Display>
+    FlushStats flush (Display& lcd) {
+        FlushStats st;
+        _last = st;
+        if (!isDirty()) return st;
+        uint16_t i = 0;
+        lcd.beginFrame();
+        while (i < SIZE) {
+            if (!_dirty.test(i)) { i++; continue; }
+            const uint16_t start = i;
+            uint16_t end = (uint16_t)(i + 1);     // esclusivo
+            uint16_t j = end;
+            while (j < SIZE && (uint16_t)(j - end) <= PCD8544_FLUSH_MERGE_GAP) {
+                if (_dirty.test(j)) end = (uint16_t)(j + 1);
+                j++;
+            }
+            lcd.writeRam(start, _buf + start, (uint16_t)(end - start));
+            st.dataBytes = (uint16_t)(st.dataBytes + (end - start));
+            st.spans++;
+            i = end;
+        }
+        lcd.endFrame();
+        _dirty.clearAll();
+        _last = st;
+        return st;
+    }
+    inline const FlushStats& lastFlush () const { return _last; }
+
+private:
+    FlushStats _last;
+};
+
+}
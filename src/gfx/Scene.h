@@ -0,0 +1,278 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include "Canvas.h"
+
+/*
+ * ** Scene **
+ * Display list "retained": un elenco di al massimo N primitive (rettangoli, linee, testo, bitmap), ognuna
+ * con la propria BlendOp, che viene composto direttamente verso il display senza framebuffer.
+ * Ogni byte di colonna inviato è calcolato al volo combinando, nell'ordine degli slot, le primitive che lo
+ * coprono (sfondo spento). La RAM dipende solo dal numero di primitive (N * ~24 byte), non dall'area.
+ *
+ * Le modifiche (moveTo, setText, setVisible, ...) vengono accumulate: commit() ridisegna solo le colonne
+ * coperte dalle primitive cambiate, nella posizione precedente e in quella nuova.
+ *
+ *      Scene<8> scene;
+ *      auto bar = scene.addFillRect(0, 40, 10, 8);
+ *      auto label = scene.addText(2, 41, "42%", BlendOp::XOR);
+ *      scene.commit(lcd);
+ *      scene.moveTo(bar, 0, 40); ... scene.commit(lcd);
+ *
+ * Testi e bitmap non vengono copiati: il puntatore deve restare valido. Dopo aver modificato un buffer
+ * "in place" chiamare touch(). Lo slot liberato da remove() viene riutilizzato dalla primitiva aggiunta dopo,
+ * che ne eredita la posizione nell'ordine di composizione.
+ */
+namespace pcd8544 {
+
+template <uint8_t N>
+class Scene {
+public:
+    using Handle = uint8_t;
+    static constexpr Handle NONE = 0xFF;
+    static constexpr uint8_t WIDTH = 84;
+    static constexpr uint8_t HEIGHT = 48;
+
+    inline void setFont (const FontInfo& f) {
+        _font = f;
+        _fontReady = f.isValid() && !f.isPacked();
+        for (Item& it : _items) if (it.kind == Kind::TEXT) refresh(it);
+    }
+
+    inline Handle addFillRect (int16_t x, int16_t y, int16_t w, int16_t h, BlendOp op = BlendOp::OR) {
+        return add(Kind::FILL, x, y, w, h, nullptr, false, op);
+    }
+    inline Handle addRect (int16_t x, int16_t y, int16_t w, int16_t h, BlendOp op = BlendOp::OR) {
+        return add(Kind::FRAME, x, y, w, h, nullptr, false, op);
+    }
+    inline Handle addHLine (int16_t x, int16_t y, int16_t w, BlendOp op = BlendOp::OR) {
+        return add(Kind::FILL, x, y, w, 1, nullptr, false, op);
+    }
+    inline Handle addVLine (int16_t x, int16_t y, int16_t h, BlendOp op = BlendOp::OR) {
+        return add(Kind::FILL, x, y, 1, h, nullptr, false, op);
+    }
+    // Testo UTF-8 con il font impostato (setFont), bordo superiore in y (pixel)
+    inline Handle addText (int16_t x, int16_t y, const char* str, BlendOp op = BlendOp::OR) {
+        return add(Kind::TEXT, x, y, 0, 0, str, false, op);
+    }
+    // Immagine nel formato di PCD8544::drawBitmap (ceil(h / 8) righe da w byte), da RAM o flash
+    inline Handle addBitmap (int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bmp, bool progmem = false, BlendOp op = BlendOp::OR) {
+        return add(Kind::BITMAP, x, y, w, h, bmp, progmem, op);
+    }
+
+    inline void moveTo (Handle h, int16_t x, int16_t y) {
+        Item* it = item(h);
+        if (!it || (it->x == x && it->y == y)) return;
+        it->x = x;
+        it->y = y;
+        it->changed = true;
+    }
+    inline void setText (Handle h, const char* str) {
+        Item* it = item(h);
+        if (!it || it->kind != Kind::TEXT) return;
+        it->src = str;
+        refresh(*it);
+    }
+    inline void setBitmap (Handle h, const uint8_t* bmp) {
+        Item* it = item(h);
+        if (!it || it->kind != Kind::BITMAP) return;
+        it->src = bmp;
+        it->changed = true;
+    }
+    inline void setOp (Handle h, BlendOp op) {
+        Item* it = item(h);
+        if (!it || it->op == op) return;
+        it->op = op;
+        it->changed = true;
+    }
+    inline void setVisible (Handle h, bool visible) {
+        Item* it = item(h);
+        if (!it || it->visible == visible) return;
+        it->visible = visible;
+        it->changed = true;
+    }
+    // Il contenuto puntato (testo o bitmap) è cambiato senza cambiare puntatore
+    inline void touch (Handle h) {
+        Item* it = item(h);
+        if (it) refresh(*it);
+    }
+    inline void remove (Handle h) {
+        Item* it = item(h);
+        if (!it) return;
+        it->kind = Kind::REMOVED;
+        it->visible = false;
+        it->changed = true;
+    }
+    // Ridisegna l'intero schermo al prossimo commit (es. dopo begin() o clear() del display)
+    inline void invalidate () { _full = true; }
+
+    /*
+     *  Function: commit
+     *  Desc: Invia al display le colonne coperte dalle primitive cambiate dall'ultimo commit (tutte dopo
+     *      invalidate() e al primo commit), in un'unica transazione SPI. Ritorna i byte dati inviati.
+     */
+    template <class Display>
+    uint16_t commit (Display& lcd) {
+        uint16_t sent = 0;
+        bool any = _full;
+        for (const Item& it : _items) any = any || it.changed;
+        if (!any) return 0;
+
+        lcd.beginFrame();
+        for (uint8_t p = 0; p < HEIGHT / 8; p++) {
+            uint8_t c = 0;
+            while (c < WIDTH) {
+                if (!damaged(c, p)) { c++; continue; }
+                const uint8_t start = c;
+                uint8_t end = (uint8_t)(c + 1);     // esclusivo
+                for (uint8_t j = end; j < WIDTH && (uint8_t)(j - end) <= PCD8544_FLUSH_MERGE_GAP; j++) {
+                    if (damaged(j, p)) end = (uint8_t)(j + 1);
+                }
+                lcd.drawGenerated(start, p, (uint8_t)(end - start), 1, [&](uint8_t col, uint8_t) {
+                    return columnByte((uint8_t)(start + col), p);
+                });
+                sent = (uint16_t)(sent + (end - start));
+                c = end;
+            }
+        }
+        lcd.endFrame();
+
+        for (Item& it : _items) {
+            if (it.kind == Kind::REMOVED) it.kind = Kind::NONE;
+            it.shown = it.visible ? Rect{it.x, it.y, it.w, it.h} : Rect{0, 0, 0, 0};
+            it.changed = false;
+        }
+        _full = false;
+        return sent;
+    }
+
+private:
+    enum class Kind : uint8_t { NONE, REMOVED, FILL, FRAME, TEXT, BITMAP };
+
+    struct Rect {
+        int16_t x, y, w, h;
+        // Il rettangolo copre almeno un pixel della colonna c nella pagina p
+        inline bool covers (uint8_t c, uint8_t p) const {
+            return w > 0 && h > 0 && c >= x && c < x + w && y < (int16_t)(p + 1) * 8 && y + h > (int16_t)p * 8;
+        }
+    };
+
+    struct Item {
+        Kind kind = Kind::NONE;
+        BlendOp op = BlendOp::OR;
+        bool visible = false;
+        bool changed = false;
+        bool progmem = false;
+        int16_t x = 0, y = 0, w = 0, h = 0;
+        const void* src = nullptr;
+        Rect shown {0, 0, 0, 0};    // area occupata sul display all'ultimo commit
+    };
+
+    Item _items[N];
+    FontInfo _font {0,0,0,0,0,0,nullptr,nullptr,nullptr,nullptr,0};
+    bool _fontReady = false;
+    bool _full = true;
+
+    inline Item* item (Handle h) {
+        return (h < N && _items[h].kind != Kind::NONE && _items[h].kind != Kind::REMOVED) ? &_items[h] : nullptr;
+    }
+
+    Handle add (Kind kind, int16_t x, int16_t y, int16_t w, int16_t h, const void* src, bool progmem, BlendOp op) {
+        for (uint8_t i = 0; i < N; i++) {
+            Item& it = _items[i];
+            if (it.kind != Kind::NONE) continue;
+            it.kind = kind;
+            it.op = op;
+            it.visible = true;
+            it.progmem = progmem;
+            it.x = x; it.y = y; it.w = w; it.h = h;
+            it.src = src;
+            refresh(it);
+            return i;
+        }
+        return NONE;
+    }
+
+    // Ricalcola le dimensioni del testo e segna la primitiva come cambiata
+    inline void refresh (Item& it) {
+        if (it.kind == Kind::TEXT) {
+            const char* s = (const char*)it.src;
+            it.w = (s && _fontReady) ? (int16_t)textWidth(_font, s, strlen(s)) : 0;
+            it.h = _font.gHeight ? _font.gHeight : 8;
+        }
+        it.changed = true;
+    }
+
+    // La colonna c della pagina p va ridisegnata
+    bool damaged (uint8_t c, uint8_t p) const {
+        if (_full) return true;
+        for (const Item& it : _items) {
+            if (!it.changed) continue;
+            if (it.shown.covers(c, p)) return true;
+            if (it.visible && Rect{it.x, it.y, it.w, it.h}.covers(c, p)) return true;
+        }
+        return false;
+    }
+
+    // Byte della pagina sp, colonna sc della sorgente di una primitiva (0 fuori range)
+    uint8_t sourceByte (const Item& it, int16_t sp, int16_t sc) const {
+        const int16_t srcPages = (int16_t)((it.h + 7) >> 3);
+        if (sp < 0 || sp >= srcPages) return 0;
+        switch (it.kind) {
+        case Kind::FILL:
+            return 0xFF;
+        case Kind::FRAME: {
+            if (sc == 0 || sc == it.w - 1) return 0xFF;
+            uint8_t b = 0;
+            if (sp == 0) b |= 0x01;
+            if (sp == ((it.h - 1) >> 3)) b |= (uint8_t)(1 << ((it.h - 1) & 7));
+            return b;
+        }
+        case Kind::TEXT: {
+            const char* s = (const char*)it.src;
+            const char* end = s + strlen(s);
+            if (!_font.isVariable()) {
+                // a larghezza fissa si salta direttamente al carattere sc / adv (i caratteri UTF-8 hanno lunghezza variabile)
+                const uint8_t adv = (uint8_t)(_font.gWidth + _font.gSpacing);
+                for (int16_t n = (int16_t)(sc / adv); n > 0 && s < end; n--) utf8Next(s, end);
+                if (s >= end) return 0;
+                const Glyph g = findGlyph(_font, utf8Next(s, end));
+                const uint8_t gc = (uint8_t)(sc % adv);
+                return gc < g.width ? g.column((uint8_t)sp, gc) : 0;
+            }
+            // font variabile: si cerca il carattere che contiene la colonna sc
+            while (s < end) {
+                const Glyph g = findGlyph(_font, utf8Next(s, end));
+                if (sc < g.width) return g.column((uint8_t)sp, (uint8_t)sc);
+                sc = (int16_t)(sc - g.width - _font.gSpacing);
+                if (sc < 0) return 0;
+            }
+            return 0;
+        }
+        case Kind::BITMAP: {
+            if (!it.src) return 0;
+            const uint8_t* p = (const uint8_t*)it.src + (uint16_t)sp * it.w + sc;
+            return it.progmem ? FONT_READ_U8(p) : *p;
+        }
+        default:
+            return 0;
+        }
+    }
+
+    // Byte finale della colonna c nella pagina p: composizione di tutte le primitive visibili
+    uint8_t columnByte (uint8_t c, uint8_t p) const {
+        uint8_t d = 0;
+        for (const Item& it : _items) {
+            if (!it.visible || !Rect{it.x, it.y, it.w, it.h}.covers(c, p)) continue;
+            const int16_t off = (int16_t)(p * 8 - it.y);
+            const int16_t sc = (int16_t)(c - it.x);
+            uint8_t mask = bits::rowMask((int16_t)-off, it.h);
+            const uint8_t v = (uint8_t)(bits::composeColumn([&](int16_t sp) { return sourceByte(it, sp, sc); }, off) & mask);
+            if (it.kind == Kind::FRAME) mask = v;     // il contorno non copre l'interno (come Canvas::drawRect)
+            d = bits::blend(d, v, mask, it.op);
+        }
+        return d;
+    }
+};
+
+}
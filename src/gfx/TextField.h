@@ -0,0 +1,110 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include "../font/FontInfo.h"
+#include "../font/Glyph.h"
+#include "../font/Number.h"
+#include "../font/Utf8.h"
+
+/*
+ * ** TextField **
+ * Campo di testo di al massimo N caratteri in una posizione fissa (x, page), che ricorda il contenuto
+ * disegnato (N codepoint, 2N + 6 byte di RAM). update() ridisegna solo le celle cambiate: ogni gruppo di celle
+ * consecutive cambiate è un unico burst preceduto da un solo posizionamento, e le colonne rimaste del testo
+ * precedente, se il nuovo è più corto, vengono azzerate.
+ *
+ *      TextField<6> counter(30, 2);
+ *      counter.update(lcd, pcd8544::Number(n, {0, 6}));   // 123456 -> 123457: una cella, 6 byte
+ *
+ * Il campo usa il font e la scala del display al momento di update(). Dopo clear() del display, o dopo aver
+ * cambiato font o scala, chiamare invalidate(): il campo viene ridisegnato per intero.
+ */
+namespace pcd8544 {
+
+template <uint8_t N>
+class TextField {
+public:
+    TextField (uint8_t x, uint8_t page) : _x(x), _page(page) {}
+
+    inline void invalidate () { _valid = false; }
+    inline void moveTo (uint8_t x, uint8_t page) { _x = x; _page = page; _valid = false; }
+
+    // Testo UTF-8 (troncato a N caratteri). Ritorna le colonne inviate.
+    template <class Display>
+    uint16_t update (Display& lcd, const char* str, bool highlighted = false) {
+        if (!str) str = "";
+        return apply(lcd, Utf8Source{str, str + strlen(str), false}, highlighted);
+    }
+    // Numero formattato (vedi font/Number.h)
+    template <class Display>
+    uint16_t update (Display& lcd, const Number& number, bool highlighted = false) {
+        return apply(lcd, number, highlighted);
+    }
+
+private:
+    // Sorgente di codepoint per drawRun(): celle [p, end) del contenuto
+    struct Cells {
+        const uint16_t* p;
+        const uint16_t* end;
+        inline bool more () const { return p < end; }
+        inline uint16_t next () { return *p++; }
+    };
+
+    uint16_t _cells[N];     // contenuto disegnato
+    uint16_t _end = 0;      // x (esclusa) della fine del testo disegnato
+    uint8_t _x, _page;
+    uint8_t _len = 0;
+    bool _highlighted = false;
+    bool _valid = false;
+
+    template <class Display, class Src>
+    uint16_t apply (Display& lcd, Src src, bool highlighted) {
+        const FontInfo& f = lcd.getFont();
+        if (!f.isValid()) return 0;
+        const uint8_t scale = f.pages() == 1 ? lcd.getTextScale() : 1;
+        auto advance = [&](uint16_t cp) {
+            return (uint16_t)(((f.isVariable() ? findGlyph(f, cp).width : f.gWidth) + f.gSpacing) * scale);
+        };
+
+        uint16_t cells[N];
+        uint8_t len = 0;
+        while (src.more() && len < N) cells[len++] = src.next();
+
+        const bool full = !_valid || highlighted != _highlighted;
+        uint16_t xOld = _x, xNew = _x;      // inizio della cella i nel contenuto disegnato e in quello nuovo
+        uint16_t sent = 0;
+        // la cella i è già sul display: stesso codepoint nella stessa posizione
+        auto clean = [&](uint8_t i) { return !full && i < _len && _cells[i] == cells[i] && xOld == xNew; };
+        auto step = [&](uint8_t i) {
+            if (i < _len) xOld = (uint16_t)(xOld + advance(_cells[i]));
+            xNew = (uint16_t)(xNew + advance(cells[i]));
+        };
+
+        lcd.beginFrame();
+        uint8_t i = 0;
+        while (i < len) {
+            if (clean(i)) { step(i++); continue; }
+            const uint8_t start = i;
+            const uint16_t x = xNew;
+            while (i < len && !clean(i)) step(i++);
+            lcd.drawRun((int16_t)x, (int16_t)(_page * 8), Cells{cells + start, cells + i}, highlighted);
+            sent = (uint16_t)(sent + (xNew - x));
+        }
+        // colonne del testo precedente oltre la fine di quello nuovo
+        if (_valid && _end > xNew && xNew < 84) {
+            const uint8_t w = (uint8_t)((_end > 84 ? 84 : _end) - xNew);
+            lcd.drawGenerated((uint8_t)xNew, _page, w, (uint8_t)(f.pages() * scale), [](uint8_t, uint8_t) { return (uint8_t)0x00; });
+            sent = (uint16_t)(sent + w);
+        }
+        lcd.endFrame();
+
+        for (uint8_t k = 0; k < len; k++) _cells[k] = cells[k];
+        _len = len;
+        _end = xNew;
+        _highlighted = highlighted;
+        _valid = true;
+        return sent;
+    }
+};
+
+}
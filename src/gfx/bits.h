@@ -0,0 +1,94 @@
+#pragma once
+#include <stdint.h>
+#include "../font/FontCompact.h"
+
+/*
+ * Operazioni sui byte di colonna (8 pixel verticali, LSB in alto) condivise dal driver e dai canvas.
+ */
+namespace pcd8544 {
+
+enum class BlendOp : uint8_t {
+    COPY,   // sovrascrive (i pixel spenti della sorgente spengono la destinazione)
+    OR,     // accende i pixel della sorgente
+    AND,    // mantiene solo i pixel accesi anche nella sorgente
+    XOR,    // inverte i pixel della sorgente
+    CLEAR   // spegne i pixel della sorgente
+};
+
+namespace bits {
+
+/*
+ *  Function: composeColumn   
+ *  Desc: Byte di una pagina del display coperta da una sorgente organizzata a pagine, spostata verticalmente.
+ *      off è la riga della sorgente che cade sul bit 0 della pagina (page * 8 - y, anche negativa);
+ *      src(sp) ritorna il byte della pagina sp della sorgente (0 fuori range).
+ */
+template <class S>
+inline uint8_t composeColumn (S&& src, int16_t off) {
+    const int16_t sp = (int16_t)(off >> 3);     // floor(off / 8)
+    const uint8_t sh = (uint8_t)(off & 7);
+    uint8_t b = (uint8_t)(src(sp) >> sh);
+    if (sh) b |= (uint8_t)(src((int16_t)(sp + 1)) << (8 - sh));
+    return b;
+}
+
+/*
+ *  Function: rowMask   
+ *  Desc: Maschera dei bit di una pagina occupati dalle righe [top, top + height), con top relativo al bit 0
+ *      della pagina (può essere negativo o maggiore di 7).
+ */
+inline uint8_t rowMask (int16_t top, int16_t height) {
+    const int16_t bottom = (int16_t)(top + height);
+    if (top >= 8 || bottom <= 0) return 0;
+    uint8_t mask = 0xFF;
+    if (top > 0) mask &= (uint8_t)(0xFF << top);
+    if (bottom < 8) mask &= (uint8_t)(0xFF >> (8 - bottom));
+    return mask;
+}
+
+/*
+ *  Function: blend   
+ *  Desc: Combina con op il byte sorgente v (già mascherato) nel byte d. mask sono i bit coperti dalla sorgente.
+ */
+inline uint8_t blend (uint8_t d, uint8_t v, uint8_t mask, BlendOp op) {
+    switch (op) {
+    case BlendOp::COPY:  return (uint8_t)((d & ~mask) | v);
+    case BlendOp::OR:    return (uint8_t)(d | v);
+    case BlendOp::AND:   return (uint8_t)(d & (v | ~mask));
+    case BlendOp::XOR:   return (uint8_t)(d ^ v);
+    case BlendOp::CLEAR: return (uint8_t)(d & ~v);
+    }
+    return d;
+}
+
+// Tabelle di espansione nibble -> bit ripetuti (ogni bit del nibble diventa 2, 3 o 4 bit uguali), in flash
+static const uint8_t SPREAD2[16] FONT_PROGMEM = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F, 0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+static const uint16_t SPREAD3[16] FONT_PROGMEM = {
+    0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF,
+    0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF
+};
+static const uint16_t SPREAD4[16] FONT_PROGMEM = {
+    0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+    0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF
+};
+
+/*
+ *  Function: spread   
+ *  Desc: Ingrandisce verticalmente un byte di colonna di un fattore scale (1..4): ogni bit viene ripetuto
+ *      scale volte. Il byte della pagina p del risultato è (spread(b, scale) >> (8 * p)) & 0xFF.
+ *      Due letture di tabella per byte, nessun ciclo sui bit.
+ */
+inline uint32_t spread (uint8_t b, uint8_t scale) {
+    const uint8_t lo = (uint8_t)(b & 0x0F), hi = (uint8_t)(b >> 4);
+    switch (scale) {
+    case 2: return (uint32_t)FONT_READ_U8(SPREAD2 + lo) | ((uint32_t)FONT_READ_U8(SPREAD2 + hi) << 8);
+    case 3: return (uint32_t)FONT_READ_U16(SPREAD3 + lo) | ((uint32_t)FONT_READ_U16(SPREAD3 + hi) << 12);
+    case 4: return (uint32_t)FONT_READ_U16(SPREAD4 + lo) | ((uint32_t)FONT_READ_U16(SPREAD4 + hi) << 16);
+    default: return b;
+    }
+}
+
+}
+}
@@ -0,0 +1,295 @@
+#pragma once
+#include <stdint.h>
+#include <Arduino.h>
+
+/*
+ * ** Pulsanti **
+ * Ingresso dei pulsanti a interrupt: l'ISR registra solo il fronte (istante, pulsante, livello) in una coda
+ * circolare senza lock, il loop la svuota quando può e ricava gli eventi. Debounce, pressione lunga e
+ * ripetizione automatica sono calcolati dal consumatore a partire dagli istanti registrati, quindi un loop
+ * lento non perde pressioni e non vede tempi sbagliati.
+ *
+ * EdgeQueue<N>         coda SPSC di fronti: un produttore (ISR) e un consumatore (loop)
+ * ButtonDecoder<NB>    fronti -> eventi (PRESS, RELEASE, LONG_PRESS, REPEAT); logica pura, senza pin né
+ *                      millis(): sul PC si alimenta con una sequenza di fronti simulata
+ * ButtonInput<NB>      collegamento ai pin: attachInterrupt(CHANGE) dove il pin lo consente, altrimenti
+ *                      campionamento in poll() nella stessa coda
+ *
+ *      pcd8544::ButtonInput<2> buttons({A0, 2}, true, true);
+ *      buttons.begin();
+ *      buttons.decoder().setRepeat(0, true);
+ *      // loop()
+ *      buttons.poll([](const pcd8544::ButtonEvent& e) { ... });
+ */
+#if defined(ARDUINO_ARCH_ESP32)
+  #define PCD8544_ISR_ATTR IRAM_ATTR
+#else
+  #define PCD8544_ISR_ATTR
+#endif
+
+namespace pcd8544 {
+
+struct Edge {
+    uint32_t ms;        // millis() al momento del fronte
+    uint8_t button;
+    uint8_t pressed;    // livello logico dopo il fronte (activeLow già applicato)
+};
+
+/*
+ *  Coda circolare di N fronti (N potenza di 2, al massimo 128) per un produttore e un consumatore.
+ *  Ciascun indice è scritto da un solo lato; gli accessi acquire/release ordinano la scrittura dell'elemento
+ *  rispetto alla pubblicazione dell'indice anche sui core con riordino della memoria (ESP32).
+ *  Se la coda è piena il fronte viene scartato e overflow() lo segnala al consumatore.
+ */
+template <uint8_t N>
+class EdgeQueue {
+    static_assert(N >= 2 && N <= 128 && (N & (N - 1)) == 0, "EdgeQueue: N deve essere una potenza di 2 (2..128)");
+public:
+    // Lato produttore (ISR)
+    inline bool push (const Edge& e) {
+        const uint8_t h = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+        if ((uint8_t)(h - __atomic_load_n(&_tail, __ATOMIC_ACQUIRE)) >= N) { _overflow = true; return false; }
+        _buf[h & (N - 1)] = e;
+        __atomic_store_n(&_head, (uint8_t)(h + 1), __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Lato consumatore (loop)
+    inline bool pop (Edge& e) {
+        const uint8_t t = __atomic_load_n(&_tail, __ATOMIC_RELAXED);
+        if (t == __atomic_load_n(&_head, __ATOMIC_ACQUIRE)) return false;
+        e = _buf[t & (N - 1)];
+        __atomic_store_n(&_tail, (uint8_t)(t + 1), __ATOMIC_RELEASE);
+        return true;
+    }
+    // Ritorna true (una volta) se dall'ultima chiamata almeno un fronte è stato scartato
+    inline bool overflow () {
+        if (!_overflow) return false;
+        _overflow = false;
+        return true;
+    }
+
+private:
+    Edge _buf[N];
+    volatile uint8_t _head = 0;     // scritto solo dal produttore
+    volatile uint8_t _tail = 0;     // scritto solo dal consumatore
+    volatile bool _overflow = false;
+};
+
+
+enum class ButtonEventType : uint8_t { PRESS, RELEASE, LONG_PRESS, REPEAT };
+
+struct ButtonEvent {
+    uint32_t ms;        // istante dell'evento (ricavato dai fronti, non dal momento della lettura)
+    uint8_t button;
+    ButtonEventType type;
+};
+
+struct ButtonTiming {
+    uint16_t debounceMs = 30;       // dopo un cambio di stato i fronti vengono ignorati per debounceMs
+    uint16_t longPressMs = 800;     // LONG_PRESS dopo longPressMs di pressione continua
+    uint16_t repeatDelayMs = 400;   // primo REPEAT dopo repeatDelayMs
+    uint16_t repeatMs = 200;        // intervallo tra i primi REPEAT...
+    uint16_t repeatMinMs = 40;      // ...che si accorcia di 1/4 a ogni ripetizione fino a repeatMinMs
+};
+
+/*
+ *  Debounce con accettazione immediata: un fronte che cambia lo stato viene accettato subito se sono passati
+ *  almeno debounceMs dal cambio precedente; i rimbalzi successivi aggiornano solo il livello grezzo, che
+ *  viene confrontato di nuovo allo scadere della finestra (così il rilascio non resta perso in un rimbalzo).
+ *  Gli eventi a tempo (LONG_PRESS, REPEAT) vengono calcolati prima di ogni cambio di stato, quindi anche
+ *  fronti letti in ritardo producono la sequenza corretta; al più un REPEAT per controllo, senza recuperi.
+ */
+template <uint8_t NB>
+class ButtonDecoder {
+    static_assert(NB >= 1 && NB <= 8, "ButtonDecoder: da 1 a 8 pulsanti");
+public:
+    inline void setTiming (const ButtonTiming& t) { _timing = t; }
+    inline const ButtonTiming& timing () const { return _timing; }
+    inline void setRepeat (uint8_t b, bool on) { setBit(_repeatMask, b, on); }
+    inline void setLongPress (uint8_t b, bool on) { setBit(_longMask, b, on); }
+    inline bool isPressed (uint8_t b) const { return b < NB && _btn[b].stable; }
+
+    // Elabora un fronte; emit(const ButtonEvent&) riceve gli eventi che ne derivano
+    template <class F>
+    void feed (const Edge& e, F&& emit) {
+        if (e.button >= NB) return;
+        State& s = _btn[e.button];
+        settle(e.button, e.ms, emit);
+        s.raw = e.pressed != 0;
+        s.rawMs = e.ms;
+        settle(e.button, e.ms, emit);
+    }
+
+    // Completa le finestre di debounce scadute ed emette gli eventi a tempo fino a now
+    template <class F>
+    void poll (uint32_t now, F&& emit) {
+        for (uint8_t b = 0; b < NB; b++) settle(b, now, emit);
+    }
+
+private:
+    struct State {
+        uint32_t changedMs = 0;     // ultimo cambio di stato accettato
+        uint32_t rawMs = 0;         // ultimo fronte
+        uint32_t nextMs = 0;        // prossimo REPEAT
+        uint16_t interval = 0;      // intervallo del prossimo REPEAT
+        bool stable = false;
+        bool raw = false;
+        bool longSent = false;
+        bool armed = false;         // la finestra di debounce del primo cambio è già trascorsa
+    };
+
+    State _btn[NB];
+    ButtonTiming _timing;
+    uint8_t _repeatMask = 0;
+    uint8_t _longMask = 0;
+
+    static inline void setBit (uint8_t& mask, uint8_t b, bool on) {
+        if (b >= NB) return;
+        if (on) mask = (uint8_t)(mask | (1 << b));
+        else mask = (uint8_t)(mask & ~(1 << b));
+    }
+
+    template <class F>
+    void settle (uint8_t b, uint32_t now, F& emit) {
+        State& s = _btn[b];
+        if (s.raw != s.stable) {
+            // il cambio avviene al fronte, o alla fine della finestra se il fronte vi cade dentro
+            const uint32_t open = s.changedMs + _timing.debounceMs;
+            uint32_t at = s.rawMs;
+            if (s.armed && (int32_t)(open - at) > 0) at = open;
+            if ((int32_t)(now - at) >= 0) {
+                if (s.stable) timed(b, at, emit);
+                s.stable = s.raw;
+                s.changedMs = at;
+                s.armed = true;
+                if (s.stable) {
+                    s.longSent = false;
+                    s.interval = _timing.repeatMs;
+                    s.nextMs = at + _timing.repeatDelayMs;
+                }
+                emit(ButtonEvent{at, b, s.stable ? ButtonEventType::PRESS : ButtonEventType::RELEASE});
+            }
+        }
+        if (s.stable) timed(b, now, emit);
+    }
+
+    template <class F>
+    void timed (uint8_t b, uint32_t now, F& emit) {
+        State& s = _btn[b];
+        if (((_longMask >> b) & 1) && !s.longSent && (int32_t)(now - (s.changedMs + _timing.longPressMs)) >= 0) {
+            s.longSent = true;
+            emit(ButtonEvent{s.changedMs + _timing.longPressMs, b, ButtonEventType::LONG_PRESS});
+        }
+        if (((_repeatMask >> b) & 1) && (int32_t)(now - s.nextMs) >= 0) {
+            emit(ButtonEvent{s.nextMs, b, ButtonEventType::REPEAT});
+            s.nextMs = now + s.interval;
+            const uint16_t shorter = (uint16_t)(s.interval - (s.interval >> 2));
+            s.interval = shorter > _timing.repeatMinMs ? shorter : _timing.repeatMinMs;
+        }
+    }
+};
+
+
+/*
+ *  NB pulsanti (al massimo 4) sui pin indicati. begin() imposta i pin e collega un'ISR CHANGE a ogni pin che
+ *  ha un interrupt (digitalPinToInterrupt); gli altri pin vengono campionati in poll(), che inserisce i
+ *  cambi di livello nella stessa coda con gli interrupt disabilitati (un solo produttore alla volta).
+ *  Una sola istanza per programma può usare gli interrupt: le ISR sono funzioni statiche.
+ *  Se la coda trabocca, poll() riallinea lo stato leggendo i pin.
+ */
+template <uint8_t NB, uint8_t QN = 16>
+class ButtonInput {
+    static_assert(NB >= 1 && NB <= 4, "ButtonInput: da 1 a 4 pulsanti");
+public:
+    ButtonInput (const uint8_t (&pins)[NB], bool activeLow, bool internalPull) : _activeLow(activeLow), _pull(internalPull) {
+        for (uint8_t b = 0; b < NB; b++) _pin[b] = pins[b];
+    }
+
+    void begin () {
+        if (_begun) return;
+        _begun = true;
+        s_self = this;
+        void (*const isr[4])() = {isrFor<0>, isrFor<1>, isrFor<2>, isrFor<3>};
+        const uint32_t now = millis();
+        for (uint8_t b = 0; b < NB; b++) {
+            pinMode(_pin[b], _pull ?
+            #if defined(ARDUINO_ARCH_ESP32)
+              (_activeLow ? INPUT_PULLUP : INPUT_PULLDOWN)
+            #else
+              (_activeLow ? INPUT_PULLUP : INPUT)
+            #endif
+              : INPUT);
+            _level[b] = read(b);
+            if (_level[b]) _decoder.feed(Edge{now, b, 1}, [](const ButtonEvent&) {});    // già premuto: nessun PRESS
+            const int irq = digitalPinToInterrupt(_pin[b]);
+            if (irq != NOT_AN_INTERRUPT) attachInterrupt(irq, isr[b], CHANGE);
+            else _sampled = (uint8_t)(_sampled | (1 << b));
+        }
+    }
+
+    void end () {
+        if (!_begun) return;
+        for (uint8_t b = 0; b < NB; b++) {
+            if (!((_sampled >> b) & 1)) detachInterrupt(digitalPinToInterrupt(_pin[b]));
+        }
+        _sampled = 0;
+        _begun = false;
+        if (s_self == this) s_self = nullptr;
+    }
+
+    // Svuota la coda e consegna gli eventi a emit(const ButtonEvent&). Da chiamare nel loop.
+    template <class F>
+    void poll (F&& emit) {
+        for (uint8_t b = 0; b < NB; b++) {
+            if ((_sampled >> b) & 1) {
+                noInterrupts();
+                capture(b);
+                interrupts();
+            }
+        }
+        Edge e;
+        while (_queue.pop(e)) _decoder.feed(e, emit);
+        const uint32_t now = millis();
+        if (_queue.overflow()) {
+            for (uint8_t b = 0; b < NB; b++) _decoder.feed(Edge{now, b, read(b)}, emit);
+        }
+        _decoder.poll(now, emit);
+    }
+
+    inline ButtonDecoder<NB>& decoder () { return _decoder; }
+
+private:
+    static ButtonInput* s_self;
+
+    EdgeQueue<QN> _queue;
+    ButtonDecoder<NB> _decoder;
+    uint8_t _pin[NB];
+    volatile uint8_t _level[NB];    // ultimo livello letto dal produttore
+    uint8_t _sampled = 0;           // pin senza interrupt, campionati in poll()
+    bool _activeLow;
+    bool _pull;
+    bool _begun = false;
+
+    inline uint8_t read (uint8_t b) const { return (uint8_t)((digitalRead(_pin[b]) == HIGH) != _activeLow); }
+
+    // Registra il fronte se il livello è cambiato dall'ultimo letto (contesto ISR o interrupt disabilitati).
+    // Il livello si aggiorna anche se la coda è piena: il riallineamento di poll() parte dai pin.
+    inline void capture (uint8_t b) {
+        const uint8_t level = read(b);
+        if (level == _level[b]) return;
+        _level[b] = level;
+        _queue.push(Edge{(uint32_t)millis(), b, level});
+    }
+
+    template <uint8_t B>
+    static void PCD8544_ISR_ATTR isrFor () {
+        if (B < NB && s_self) s_self->capture(B);
+    }
+};
+
+// Definizione fuori dalla classe (niente variabili inline, il core AVR compila con gnu++11)
+template <uint8_t NB, uint8_t QN>
+ButtonInput<NB, QN>* ButtonInput<NB, QN>::s_self = nullptr;
+
+}
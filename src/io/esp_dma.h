@@ -0,0 +1,90 @@
+#pragma once
+#if defined(ARDUINO_ARCH_ESP32)
+#include <Arduino.h>
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+#include "pins.h"
+#include "segments.h"
+
+/*
+ * ** EspDmaSink **
+ * Sink di SegmentTransport per ESP32: ogni segmento è una transazione spi_device di ESP-IDF trasmessa in DMA.
+ * CS è gestito dalla periferica SPI (spics_io_num) e D/C viene impostato dalla callback pre-trasferimento
+ * (pre_cb), chiamata dal driver SPI prima di ogni transazione: nessun GPIO commutato dal codice del driver
+ * tra un segmento e l'altro. send() accoda le transazioni e ritorna subito (oltre SEGS segmenti attende i
+ * gruppi precedenti); wait() raccoglie i risultati.
+ *
+ * Il bus SPI (di default SPI2_HOST, l'HSPI dell'ESP32 classico) viene inizializzato da begin() ed è
+ * dedicato al display: non condividerlo con SPIClass. I buffer di SegmentTransport devono stare nella RAM
+ * interna (oggetto globale o statico), che è accessibile al DMA.
+ */
+namespace pcd8544 {
+
+template <uint8_t SEGS = 16, uint16_t MAX_TRANSFER = 1024>
+class EspDmaSink {
+public:
+    EspDmaSink (const Pins& pins, uint32_t hz = 4000000, spi_host_device_t host = SPI2_HOST)
+        : _pins(pins), _hz(hz), _host(host) {}
+
+    void begin () {
+        if (_dev) return;
+        gpio_reset_pin((gpio_num_t)_pins.dc);
+        gpio_set_direction((gpio_num_t)_pins.dc, GPIO_MODE_OUTPUT);
+
+        spi_bus_config_t bus = {};
+        bus.mosi_io_num = _pins.mosi;
+        bus.miso_io_num = -1;
+        bus.sclk_io_num = _pins.sclk;
+        bus.quadwp_io_num = -1;
+        bus.quadhd_io_num = -1;
+        bus.max_transfer_sz = MAX_TRANSFER;
+        spi_bus_initialize(_host, &bus, SPI_DMA_CH_AUTO);
+
+        spi_device_interface_config_t dev = {};
+        dev.mode = 0;
+        dev.clock_speed_hz = (int)_hz;
+        dev.spics_io_num = _pins.cs;
+        dev.queue_size = SEGS;
+        dev.pre_cb = preTransfer;
+        spi_bus_add_device(_host, &dev, &_dev);
+    }
+
+    // Con più segmenti di SEGS (SegmentTransport configurato con più segmenti del Sink) le transazioni vengono
+    // accodate a gruppi di SEGS, attendendo il gruppo precedente prima di riusarne i descrittori
+    void send (const uint8_t* buf, const Segment* segs, uint8_t count) {
+        for (uint8_t i = 0; i < count; i++) {
+            const uint8_t slot = (uint8_t)(i % SEGS);
+            if (i && !slot) wait();
+            spi_transaction_t& t = _trans[slot];
+            memset(&t, 0, sizeof(t));
+            t.length = (size_t)segs[i].length * 8;
+            t.tx_buffer = buf + segs[i].offset;
+            // la callback riceve pin e livello di D/C nel campo user
+            t.user = (void*)(uintptr_t)(((uint32_t)_pins.dc << 1) | segs[i].data);
+            if (spi_device_queue_trans(_dev, &t, portMAX_DELAY) == ESP_OK) _pending++;
+        }
+    }
+    void wait () {
+        spi_transaction_t* done;
+        while (_pending) {
+            spi_device_get_trans_result(_dev, &done, portMAX_DELAY);
+            _pending--;
+        }
+    }
+
+private:
+    Pins _pins;
+    uint32_t _hz;
+    spi_host_device_t _host;
+    spi_device_handle_t _dev = nullptr;
+    spi_transaction_t _trans[SEGS];     // in uso fino a wait(): un solo invio alla volta
+    uint8_t _pending = 0;
+
+    static void IRAM_ATTR preTransfer (spi_transaction_t* t) {
+        const uint32_t u = (uint32_t)(uintptr_t)t->user;
+        gpio_set_level((gpio_num_t)(u >> 1), u & 1);
+    }
+};
+
+}
+#endif
@@ -0,0 +1,135 @@
+#pragma once
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_IDF_TARGET_ESP32)
+  #include "soc/gpio_struct.h"
+#endif
+
+/*
+ * ** Pin I/O **
+ * Politiche di accesso ai pin CS, DC e RST del display, usate come parametro template da SpiTransport
+ * (vedi io/transport.h).
+ * Ogni politica espone:
+ *  - begin(): configura i pin in uscita (CS alto)
+ *  - csHigh(), csLow(), dcData(), dcCmd(), rstHigh(), rstLow()
+ *
+ * RuntimePins      pin scelti a runtime, digitalWrite (funziona su qualsiasi core)
+ * FastPins<...>    pin noti a compile-time, scrittura diretta dei registri:
+ *                  - AVR ATmega48/88/168/328(P): sbi/cbi su PORTB/C/D (2 cicli, atomici)
+ *                  - altri AVR: registro e maschera letti una volta in begin()
+ *                  - ESP32: GPIO.out_w1ts / out_w1tc (una scrittura a 32 bit)
+ *                  - altri core: digitalWrite con pin costante
+ */
+namespace pcd8544 {
+
+struct Pins {
+    int8_t sclk;
+    int8_t mosi;
+    int8_t cs;
+    int8_t dc;
+    int8_t rst;
+    int8_t bl;
+};
+
+class RuntimePins {
+public:
+    RuntimePins (const Pins& p) : _cs(p.cs), _dc(p.dc), _rst(p.rst) {}
+
+    inline void begin () {
+        pinMode(_cs, OUTPUT);
+        csHigh();
+        pinMode(_dc, OUTPUT);
+        pinMode(_rst, OUTPUT);
+    }
+    inline void csHigh () { digitalWrite(_cs, HIGH); }
+    inline void csLow () { digitalWrite(_cs, LOW); }
+    inline void dcData () { digitalWrite(_dc, HIGH); }
+    inline void dcCmd () { digitalWrite(_dc, LOW); }
+    inline void rstHigh () { digitalWrite(_rst, HIGH); }
+    inline void rstLow () { digitalWrite(_rst, LOW); }
+
+private:
+    int8_t _cs, _dc, _rst;
+};
+
+
+/*
+ *  FastPin<P>: scrittura di un singolo pin noto a compile-time.
+ */
+#if defined(ARDUINO_ARCH_AVR) && (defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega168__) || defined(__AVR_ATmega88__) || defined(__AVR_ATmega48__))
+// Mappatura pin Arduino (Uno/Nano/Pro Mini): 0-7 PORTD, 8-13 PORTB, 14-19 PORTC.
+// Con P costante ogni ramo si riduce a una sola istruzione sbi/cbi.
+template <uint8_t P>
+struct FastPin {
+    static_assert(P < 20, "FastPin: pin non valido per ATmega328");
+    static inline void begin () { pinMode(P, OUTPUT); }
+    static inline void high () {
+        if (P < 8) PORTD |= (uint8_t)(1 << P);
+        else if (P < 14) PORTB |= (uint8_t)(1 << (P - 8));
+        else PORTC |= (uint8_t)(1 << (P - 14));
+    }
+    static inline void low () {
+        if (P < 8) PORTD &= (uint8_t)~(1 << P);
+        else if (P < 14) PORTB &= (uint8_t)~(1 << (P - 8));
+        else PORTC &= (uint8_t)~(1 << (P - 14));
+    }
+};
+#elif defined(ARDUINO_ARCH_AVR)
+// Altri AVR: la tabella pin -> porta è in PROGMEM (non constexpr), quindi registro e maschera
+// vengono letti una volta sola in begin(). La scrittura read-modify-write è protetta da cli().
+template <uint8_t P>
+struct FastPin {
+    static inline volatile uint8_t* reg = nullptr;
+    static inline uint8_t mask = 0;
+    static inline void begin () {
+        pinMode(P, OUTPUT);
+        reg = portOutputRegister(digitalPinToPort(P));
+        mask = digitalPinToBitMask(P);
+    }
+    static inline void high () { const uint8_t s = SREG; cli(); *reg |= mask; SREG = s; }
+    static inline void low () { const uint8_t s = SREG; cli(); *reg &= (uint8_t)~mask; SREG = s; }
+};
+#elif defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_IDF_TARGET_ESP32)
+// ESP32: registri W1TS/W1TC, atomici per costruzione (nessun read-modify-write)
+template <uint8_t P>
+struct FastPin {
+    static_assert(P < 40, "FastPin: pin non valido per ESP32");
+    static inline void begin () { pinMode(P, OUTPUT); }
+    static inline void high () {
+        if (P < 32) GPIO.out_w1ts = (uint32_t)1 << P;
+        else GPIO.out1_w1ts.val = (uint32_t)1 << (P - 32);
+    }
+    static inline void low () {
+        if (P < 32) GPIO.out_w1tc = (uint32_t)1 << P;
+        else GPIO.out1_w1tc.val = (uint32_t)1 << (P - 32);
+    }
+};
+#else
+template <uint8_t P>
+struct FastPin {
+    static inline void begin () { pinMode(P, OUTPUT); }
+    static inline void high () { digitalWrite(P, HIGH); }
+    static inline void low () { digitalWrite(P, LOW); }
+};
+#endif
+
+template <uint8_t CS, uint8_t DC, uint8_t RST>
+class FastPins {
+public:
+    FastPins (const Pins&) {}
+
+    inline void begin () {
+        FastPin<CS>::begin();
+        csHigh();
+        FastPin<DC>::begin();
+        FastPin<RST>::begin();
+    }
+    inline void csHigh () { FastPin<CS>::high(); }
+    inline void csLow () { FastPin<CS>::low(); }
+    inline void dcData () { FastPin<DC>::high(); }
+    inline void dcCmd () { FastPin<DC>::low(); }
+    inline void rstHigh () { FastPin<RST>::high(); }
+    inline void rstLow () { FastPin<RST>::low(); }
+};
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * ** Segmenti **
+ * Byte per il display raggruppati per livello di D/C: ogni segmento è una sequenza di comandi o di dati
+ * contigua in un buffer, trasmissibile con un solo trasferimento (es. una transazione DMA).
+ * SegmentBuilder non dipende dall'hardware: con RecordingSink l'ordine e il contenuto dei segmenti prodotti
+ * dal driver si verificano anche sul PC.
+ */
+namespace pcd8544 {
+
+struct Segment {
+    uint16_t offset;    // inizio nel buffer (multiplo di 4)
+    uint16_t length;    // byte
+    uint8_t data;       // 1: dati (D/C alto), 0: comandi
+};
+
+/*
+ *  Raccoglie i byte in un buffer di CAP byte, al massimo SEGS segmenti. Un byte con lo stesso livello di D/C
+ *  dell'ultimo segmento lo allunga, altrimenti apre un segmento nuovo, allineato a 4 byte (il DMA di ESP32
+ *  trasmette direttamente solo da indirizzi allineati, altrimenti il driver SPI copia il buffer).
+ */
+template <uint16_t CAP, uint8_t SEGS>
+class SegmentBuilder {
+    static_assert(CAP >= 8 && SEGS >= 1, "SegmentBuilder: buffer troppo piccolo");
+public:
+    inline void reset (uint8_t* buf) {
+        _buf = buf;
+        _count = 0;
+        _used = 0;
+    }
+
+    // Aggiunge fino a n byte con il livello D/C indicato; ritorna quanti ne ha accettati (0: buffer o
+    // segmenti esauriti, va consegnato e ripreso con reset())
+    uint16_t append (const uint8_t* src, uint16_t n, bool data) {
+        if (!_count || _seg[_count - 1].data != (uint8_t)data) {
+            const uint16_t start = (uint16_t)((_used + 3) & ~3u);
+            if (_count == SEGS || start >= CAP) return 0;
+            _seg[_count++] = Segment{start, 0, (uint8_t)data};
+            _used = start;
+        }
+        const uint16_t k = n < (uint16_t)(CAP - _used) ? n : (uint16_t)(CAP - _used);
+        memcpy(_buf + _used, src, k);
+        _used = (uint16_t)(_used + k);
+        _seg[_count - 1].length = (uint16_t)(_seg[_count - 1].length + k);
+        return k;
+    }
+
+    inline uint8_t count () const { return _count; }
+    inline const Segment* segments () const { return _seg; }
+    inline uint16_t used () const { return _used; }
+
+private:
+    uint8_t* _buf = nullptr;
+    Segment _seg[SEGS];
+    uint16_t _used = 0;
+    uint8_t _count = 0;
+};
+
+
+/*
+ *  Sink che registra in memoria i segmenti ricevuti (livello D/C, lunghezza e i primi BYTES byte di
+ *  contenuto in totale), senza hardware: per i test e i benchmark sul PC. I contatori proseguono anche
+ *  quando il registro è pieno.
+ */
+template <uint16_t BYTES = 1024, uint16_t RECORDS = 64>
+class RecordingSink {
+public:
+    struct Record {
+        uint16_t offset;    // inizio in bytes()
+        uint16_t length;
+        uint8_t data;
+        uint16_t send;      // numero dell'invio (send()) che lo conteneva
+    };
+
+    inline void begin () {}
+    void send (const uint8_t* buf, const Segment* segs, uint8_t count) {
+        for (uint8_t i = 0; i < count; i++) {
+            if (_records < RECORDS) {
+                const uint16_t k = segs[i].length < (uint16_t)(BYTES - _used) ? segs[i].length : (uint16_t)(BYTES - _used);
+                memcpy(_bytes + _used, buf + segs[i].offset, k);
+                _record[_records++] = Record{_used, k, segs[i].data, (uint16_t)_sends};
+                _used = (uint16_t)(_used + k);
+            }
+            _segments++;
+            _total += segs[i].length;
+        }
+        _sends++;
+    }
+    inline void wait () {}
+
+    inline void clear () { _records = 0; _used = 0; _sends = 0; _segments = 0; _total = 0; }
+    inline uint16_t records () const { return _records; }
+    inline const Record& record (uint16_t i) const { return _record[i]; }
+    inline const uint8_t* bytes () const { return _bytes; }
+    inline uint32_t sends () const { return _sends; }           // invii (= trasferimenti DMA raggruppati)
+    inline uint32_t segments () const { return _segments; }     // segmenti (= transazioni)
+    inline uint32_t totalBytes () const { return _total; }
+
+private:
+    Record _record[RECORDS];
+    uint8_t _bytes[BYTES];
+    uint16_t _records = 0;
+    uint16_t _used = 0;
+    uint32_t _sends = 0;
+    uint32_t _segments = 0;
+    uint32_t _total = 0;
+};
+
+}
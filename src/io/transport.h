@@ -0,0 +1,271 @@
+#pragma once
+#include <Arduino.h>
+#include <SPI.h>
+#include "pins.h"
+#include "segments.h"
+
+/*
+ * Trasferimenti a blocco: i byte vengono inviati a gruppi tramite un piccolo buffer di appoggio
+ * (sullo stack, solo durante il trasferimento) invece che uno alla volta.
+ * - ESP32/ESP8266: SPIClass::writeBytes (nessuna lettura, il buffer non viene sovrascritto)
+ * - altri core (AVR, ...): SPIClass::transfer(buf, len), che lavora in-place sul buffer di appoggio
+ * PCD8544_STAGE_SIZE può essere ridefinita prima dell'include (min 1).
+ */
+#ifndef PCD8544_STAGE_SIZE
+#define PCD8544_STAGE_SIZE 16
+#endif
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+#define PCD8544_SPI_WRITE_BYTES 1
+#endif
+
+/*
+ * ** Trasporto **
+ * Politiche di accesso al bus, usate come parametro template da PCD8544Base. Ogni trasporto espone:
+ *  - begin(): configura bus e pin (CS alto)
+ *  - beginTransaction(), endTransaction(): bus riservato al display
+ *  - csLow(), csHigh(), dcCmd(), dcData(), rstLow(), rstHigh()
+ *  - write(b): un byte; write(buf, n): n byte da RAM, buf non viene modificato;
+ *    writeGenerated(n, gen): n byte prodotti da gen(i), i = 0..n-1 (write_P, writeZeros, riempimenti, ...)
+ * Tutte le funzioni sono inline: con un trasporto noto a compile-time il driver chiama direttamente SPIClass
+ * o scrive i registri, senza funzioni virtuali né puntatori a funzione.
+ *
+ * SpiTransport<PinIo>          SPIClass di Arduino, CS/DC/RST tramite la politica dei pin (io/pins.h)
+ * SegmentTransport<Sink>       i byte diventano segmenti con lo stesso livello di D/C (io/segments.h),
+ *                              consegnati a un Sink: DMA di ESP-IDF (EspDmaSink), oppure un registratore
+ * UsartSpiTransport<PinIo>     USART0 in modalità Master SPI su ATmega328 (io/usart_spi.h)
+ * RecordingTransport<BYTES>    nessun bus: registra byte, livello di D/C e cicli di CS (test e benchmark)
+ */
+namespace pcd8544 {
+
+template <class PinIo>
+class SpiTransport {
+public:
+    SpiTransport (SPIClass& spi, const Pins& pins, uint32_t hz, uint8_t mode)
+        : _spi(spi), _io(pins), _sclk(pins.sclk), _mosi(pins.mosi), _hz(hz), _mode(mode) {}
+
+    inline void begin () {
+        _io.begin();    // CS, DC, RST in uscita (CS alto)
+        if (_sclk >= 0 && _mosi >= 0) _spi.begin(_sclk, -1, _mosi);
+        else _spi.begin();
+    }
+    inline void beginTransaction () { _spi.beginTransaction(SPISettings(_hz, MSBFIRST, _mode)); }
+    inline void endTransaction () { _spi.endTransaction(); }
+    inline void csLow () { _io.csLow(); }
+    inline void csHigh () { _io.csHigh(); }
+    inline void dcCmd () { _io.dcCmd(); }
+    inline void dcData () { _io.dcData(); }
+    inline void rstLow () { _io.rstLow(); }
+    inline void rstHigh () { _io.rstHigh(); }
+
+    inline void write (uint8_t b) { _spi.transfer(b); }
+    inline void write (const uint8_t* buf, size_t n) {
+        #if defined(PCD8544_SPI_WRITE_BYTES)
+            _spi.writeBytes(buf, n);
+        #else
+            // transfer(buf, len) sovrascrive il buffer con i byte ricevuti: si passa da una copia
+            uint8_t stage[PCD8544_STAGE_SIZE];
+            while (n) {
+                const size_t k = n < sizeof(stage) ? n : sizeof(stage);
+                memcpy(stage, buf, k);
+                _spi.transfer(stage, k);
+                buf += k;
+                n -= k;
+            }
+        #endif
+    }
+    // I byte generati passano da un buffer di appoggio sullo stack, inviato con un solo trasferimento
+    template <class G>
+    inline void writeGenerated (size_t n, G&& gen) {
+        uint8_t stage[PCD8544_STAGE_SIZE];
+        size_t i = 0;
+        while (n) {
+            const size_t k = n < sizeof(stage) ? n : sizeof(stage);
+            for (size_t j = 0; j < k; j++) stage[j] = gen(i++);
+            #if defined(PCD8544_SPI_WRITE_BYTES)
+                _spi.writeBytes(stage, k);
+            #else
+                _spi.transfer(stage, k);
+            #endif
+            n -= k;
+        }
+    }
+
+private:
+    SPIClass& _spi;
+    PinIo _io;
+    int8_t _sclk, _mosi;
+    uint32_t _hz;
+    uint8_t _mode;
+};
+
+
+/*
+ *  SegmentTransport<Sink, CAP, SEGS>: i byte scritti vengono raccolti in segmenti (byte consecutivi con lo
+ *  stesso livello di D/C) in un buffer di CAP byte, e consegnati al Sink alla fine della transazione, a CS
+ *  rilasciato fuori da una transazione, o a buffer pieno. I buffer sono due: mentre il Sink trasmette il
+ *  primo (es. DMA) il driver prepara i segmenti nel secondo, e prima di riusare un buffer si attende che il
+ *  trasferimento precedente sia terminato (Sink::wait()).
+ *  CS e D/C non vengono commutati qui: ogni segmento porta il suo livello di D/C, il Sink li applica.
+ *  Il pin RST resta un GPIO: prima di commutarlo si attende la fine dei trasferimenti.
+ *  Con i dati di un frame completo (6 comandi di posizionamento + 504 byte) bastano pochi segmenti.
+ *
+ *  Sink:
+ *      void begin ()
+ *      void send (const uint8_t* buf, const Segment* segs, uint8_t count)   // può ritornare prima della fine
+ *      void wait ()                                                        // attende gli invii precedenti
+ */
+template <class Sink, uint16_t CAP = 576, uint8_t SEGS = 16>
+class SegmentTransport {
+public:
+    template <class... A>
+    SegmentTransport (const Pins& pins, A&&... sinkArgs) : _sink(static_cast<A&&>(sinkArgs)...), _rst(pins.rst) {
+        _seg.reset(_buf[0]);
+    }
+
+    inline void begin () {
+        if (_rst >= 0) pinMode(_rst, OUTPUT);
+        _sink.begin();
+    }
+    inline void beginTransaction () { _inTransaction = true; }
+    inline void endTransaction () {
+        _inTransaction = false;
+        flush();
+    }
+    inline void csLow () {}
+    // Fuori da una transazione il rilascio di CS chiude l'invio (es. comandi singoli)
+    inline void csHigh () { if (!_inTransaction) flush(); }
+    inline void dcCmd () { _data = false; }
+    inline void dcData () { _data = true; }
+    inline void rstLow () { sync(); if (_rst >= 0) digitalWrite(_rst, LOW); }
+    inline void rstHigh () { sync(); if (_rst >= 0) digitalWrite(_rst, HIGH); }
+
+    inline void write (uint8_t b) { write(&b, 1); }
+    void write (const uint8_t* buf, size_t n) {
+        while (n) {
+            const uint16_t k = _seg.append(buf, n > 0xFFFF ? 0xFFFF : (uint16_t)n, _data);
+            if (!k) { flush(); continue; }
+            buf += k;
+            n -= k;
+        }
+    }
+    template <class G>
+    void writeGenerated (size_t n, G&& gen) {
+        uint8_t stage[PCD8544_STAGE_SIZE];
+        size_t i = 0;
+        while (n) {
+            const size_t k = n < sizeof(stage) ? n : sizeof(stage);
+            for (size_t j = 0; j < k; j++) stage[j] = gen(i++);
+            write(stage, k);
+            n -= k;
+        }
+    }
+
+    // Consegna i segmenti raccolti e passa all'altro buffer
+    void flush () {
+        if (!_seg.count()) return;
+        _sink.wait();       // invio precedente, dall'altro buffer, terminato
+        _sink.send(_buf[_cur], _seg.segments(), _seg.count());
+        _cur ^= 1;
+        _seg.reset(_buf[_cur]);
+    }
+    // Attende che tutti i byte scritti siano stati trasmessi
+    inline void sync () {
+        flush();
+        _sink.wait();
+    }
+    inline Sink& sink () { return _sink; }
+
+private:
+    Sink _sink;
+    SegmentBuilder<CAP, SEGS> _seg;
+    alignas(4) uint8_t _buf[2][CAP];
+    int8_t _rst;
+    uint8_t _cur = 0;
+    bool _data = false;
+    bool _inTransaction = false;
+};
+
+
+/*
+ *  RecordingTransport<BYTES>: trasporto senza hardware. Registra i primi BYTES byte scritti con il loro
+ *  livello di D/C e conta byte, cicli di CS, cambi di D/C, transazioni e chiamate di scrittura: l'output del
+ *  driver si verifica sul PC senza emulare SPIClass e i pin. I contatori proseguono a registro pieno.
+ *  Es.: PCD8544Recording<> rec({-1, -1, 10, 9, 8, -1});
+ *       rec.print("Hello"); rec.transport().counters().dataBytes ...
+ */
+template <uint16_t BYTES = 1024>
+class RecordingTransport {
+public:
+    struct Counters {
+        uint32_t dataBytes = 0;
+        uint32_t cmdBytes = 0;
+        uint32_t csCycles = 0;      // fronti di discesa di CS
+        uint32_t dcToggles = 0;
+        uint32_t transactions = 0;
+        uint32_t writeCalls = 0;    // chiamate write/writeGenerated (a prescindere dal numero di byte)
+        uint32_t resets = 0;
+    };
+
+    RecordingTransport () = default;
+    RecordingTransport (const Pins&) {}
+
+    inline void begin () { _csHigh = true; }
+    inline void beginTransaction () { _c.transactions++; }
+    inline void endTransaction () {}
+    inline void csLow () {
+        if (_csHigh) _c.csCycles++;
+        _csHigh = false;
+    }
+    inline void csHigh () { _csHigh = true; }
+    inline void dcCmd () { level(false); }
+    inline void dcData () { level(true); }
+    inline void rstLow () { _c.resets++; }
+    inline void rstHigh () {}
+
+    inline void write (uint8_t b) {
+        _c.writeCalls++;
+        put(b);
+    }
+    inline void write (const uint8_t* buf, size_t n) {
+        _c.writeCalls++;
+        while (n--) put(*buf++);
+    }
+    template <class G>
+    inline void writeGenerated (size_t n, G&& gen) {
+        _c.writeCalls++;
+        for (size_t i = 0; i < n; i++) put(gen(i));
+    }
+
+    inline void clear () {
+        _c = Counters();
+        _used = 0;
+    }
+    inline const Counters& counters () const { return _c; }
+    inline uint16_t recorded () const { return _used; }
+    inline uint8_t byteAt (uint16_t i) const { return _bytes[i]; }
+    inline bool isData (uint16_t i) const { return _dataMask[i >> 3] & (1 << (i & 7)); }
+
+private:
+    uint8_t _bytes[BYTES];
+    uint8_t _dataMask[(BYTES + 7) / 8];
+    Counters _c;
+    uint16_t _used = 0;
+    bool _data = false;
+    bool _csHigh = true;
+
+    inline void level (bool data) {
+        if (data != _data) _c.dcToggles++;
+        _data = data;
+    }
+    inline void put (uint8_t b) {
+        if (_data) _c.dataBytes++;
+        else _c.cmdBytes++;
+        if (_used >= BYTES) return;
+        const uint8_t bit = (uint8_t)(1 << (_used & 7));
+        if (_data) _dataMask[_used >> 3] |= bit;
+        else _dataMask[_used >> 3] &= (uint8_t)~bit;
+        _bytes[_used++] = b;
+    }
+};
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <Arduino.h>
+#include <SPI.h>
+#include "pins.h"
+
+/*
+ * ** UsartSpiTransport **
+ * Trasporto per ATmega48/88/168/328(P) (Uno, Nano, Pro Mini): la USART0 in modalità Master SPI (MSPIM)
+ * trasmette i byte al display, lasciando il bus SPI hardware (pin 11/12/13) libero per altre periferiche,
+ * es. una scheda SD con la sua libreria e le sue transazioni.
+ *  - SCLK: pin 4 (XCK0), MOSI: pin 1 (TXD0); pins.sclk e pins.mosi vengono ignorati
+ *  - CS, DC, RST: politica dei pin (io/pins.h), come per SpiTransport
+ *  - clock = F_CPU / (2 * (UBRR0 + 1)): con 16 MHz al massimo 8 MHz, il PCD8544 ne accetta 4
+ * La USART0 è quella di Serial: dopo begin() Serial non va usata (né Serial.begin()).
+ *
+ * Il registro di trasmissione è doppio: un byte si scrive appena UDRE0 lo consente, mentre il precedente sta
+ * ancora uscendo, quindi i byte generati (write_P, riempimenti) non passano da un buffer di appoggio.
+ * Prima di commutare CS, DC o RST si attende la fine dell'ultimo byte (TXC0).
+ */
+#if defined(ARDUINO_ARCH_AVR) && defined(UBRR0) && (defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega168__) || defined(__AVR_ATmega88__) || defined(__AVR_ATmega48__))
+#define PCD8544_HAS_USART_SPI 1
+
+namespace pcd8544 {
+
+template <class PinIo>
+class UsartSpiTransport {
+public:
+    static constexpr uint8_t XCK_PIN = 4;   // PD4
+
+    UsartSpiTransport (const Pins& pins, uint32_t hz = 4000000, uint8_t mode = SPI_MODE0)
+        : _io(pins), _hz(hz), _mode(mode) {}
+
+    void begin () {
+        _io.begin();    // CS, DC, RST in uscita (CS alto)
+        UBRR0 = 0;
+        pinMode(XCK_PIN, OUTPUT);
+        // MSPIM (UMSEL01:0 = 11), MSB per primo (UDORD0 = 0); UCPHA0 e UCPOL0 dal modo SPI
+        UCSR0C = (uint8_t)(_BV(UMSEL01) | _BV(UMSEL00)
+            | ((_mode & 0x04) ? _BV(1) /* UCPHA0 */ : 0)
+            | ((_mode & 0x08) ? _BV(UCPOL0) : 0));
+        UCSR0B = _BV(TXEN0);    // solo trasmissione: RXD0 (pin 0) resta libero
+        // il baud rate va impostato dopo aver abilitato il trasmettitore (datasheet, "USART in SPI Mode")
+        const uint32_t div = F_CPU / (2 * (_hz ? _hz : 1));
+        UBRR0 = div > 1 ? (uint16_t)(div - 1) : 0;
+        _busy = false;
+    }
+    // Bus dedicato al display: nessuna transazione da condividere
+    inline void beginTransaction () {}
+    inline void endTransaction () { drain(); }
+    inline void csLow () { drain(); _io.csLow(); }
+    inline void csHigh () { drain(); _io.csHigh(); }
+    inline void dcCmd () { drain(); _io.dcCmd(); }
+    inline void dcData () { drain(); _io.dcData(); }
+    inline void rstLow () { drain(); _io.rstLow(); }
+    inline void rstHigh () { drain(); _io.rstHigh(); }
+
+    inline void write (uint8_t b) {
+        while (!(UCSR0A & _BV(UDRE0))) {}
+        // Azzeramento di TXC0 e scrittura di UDR0 senza interrupt in mezzo: un'ISR lunga potrebbe lasciar finire
+        // il byte precedente e rialzare TXC0 prima che il nuovo entri, e drain() tornerebbe in anticipo
+        const uint8_t sreg = SREG;
+        cli();
+        UCSR0A = _BV(TXC0);     // azzera TXC0 (gli altri bit scrivibili devono restare a 0 in MSPIM)
+        UDR0 = b;
+        SREG = sreg;
+        _busy = true;
+    }
+    inline void write (const uint8_t* buf, size_t n) {
+        while (n--) write(*buf++);
+    }
+    template <class G>
+    inline void writeGenerated (size_t n, G&& gen) {
+        for (size_t i = 0; i < n; i++) write(gen(i));
+    }
+
+private:
+    PinIo _io;
+    uint32_t _hz;
+    uint8_t _mode;
+    bool _busy = false;
+
+    // Attende che l'ultimo byte sia uscito completamente dal registro a scorrimento
+    inline void drain () {
+        if (!_busy) return;
+        while (!(UCSR0A & _BV(TXC0))) {}
+        _busy = false;
+    }
+};
+
+}
+#endif
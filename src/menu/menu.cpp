@@ -1,67 +1,68 @@
 #include "menu.h"
 #include "../PCD8544.h"
 
-void MenuController::scanButtons_ () {
-    // Funzione per leggere lo stato dei pulsanti, tenendo conto di activeLow
-    auto rd = [&](Btn& btn) {
-        bool raw = digitalRead(btn.pin);
-        return _pins.activeLow ? !raw : raw;
-    };
-
-    // Funzione interna per gestire ciascun pulsante (con debounce)
-    auto step = [&](Btn& btn, void (MenuController::*onPress)()) {
-        bool now = rd(btn); // Legge il pulsante (in questo istante)
-        unsigned long m = millis(); // tempo attuale
-        if (now != btn.last && (m - btn.t) >= _pins.debounceMs) {
-            btn.last = now; // aggiorna ultimo valore pulsante
-            btn.t = m;  // aggiorna tempo pulsante
-
-            // Evento di pressione: non era premuto -> ora lo è
-            if (now && !btn.state) {
-                btn.state = true;   // aggiorna stato pulsante = premuto
-                (this->*onPress)();  // chiama l'azione associata al pulsante
-            } else if (!now && btn.state) {  // Evento di rilascio: era premuto -> ora non lo è
-                btn.state = false;
-            }
+void MenuController::update () {
+    _buttons.begin();
+    _buttons.poll([this](const pcd8544::ButtonEvent& e) {
+        using T = pcd8544::ButtonEventType;
+        if (e.type != T::PRESS && e.type != T::REPEAT) return;
+        switch (e.button) {
+            case BTN_BACK: onPressBack_(); break;
+            case BTN_FORWARD: onPressForward_(); break;
+            case BTN_SELECT: onPressSelect_(); break;
         }
-    };
-
-    // Applica il controllo ai pulsanti
-    step(_bBack, &MenuController::onPressBack_);
-    step(_bFwd, &MenuController::onPressForward_);
-    step(_bSel, &MenuController::onPressSelect_);
+    });
 }
 
 
+static constexpr uint8_t FIRST_ITEM_ROW = 2;
+static constexpr uint8_t MAX_ITEMS_IN_MENU = PAGES - FIRST_ITEM_ROW;
+static constexpr uint8_t ITEM_INDENT = 7;   // colonna delle voci non selezionate
+
 void MenuController::displayMenu () {
     if (!_lcd || !_current) return;
 
-    _lcd->clear();
-    delay(2);
-    //_lcd->fillRow(_cursor);
-    _lcd->drawStraightLine(0, 83, 10, true, 1);
-    _lcd->printStringCentered(_current->label, 0, true);
-    uint8_t firstItemRow = 2;
-    uint8_t maxItemsInMenu = PAGES - firstItemRow;
-    int16_t scroll = 0;
-    
-    for (uint8_t item = 0; item < _current->childCount; item++) {
-        
-        scroll = maxItemsInMenu - 1 - _cursor;
-        scroll = scroll < 0 ? - scroll : 0;
-        if (item >= maxItemsInMenu) return;
-        
-        _lcd->setCursor((item == _cursor || (scroll > 0 && item == maxItemsInMenu - 1)) 
-                        ? 0 : 7, item + firstItemRow);
-        if (item == _cursor || (scroll > 0 && item == maxItemsInMenu - 1)) _lcd->print("> ");
-        _lcd->print(_current->children[item + scroll].label);
+    // la selezione scorre fino all'ultima riga visibile, poi scorrono le voci
+    const uint8_t scroll = _cursor >= MAX_ITEMS_IN_MENU ? (uint8_t)(_cursor - (MAX_ITEMS_IN_MENU - 1)) : 0;
+    const uint8_t row = (uint8_t)(_cursor - scroll);
+    const uint8_t rows = _current->childCount < MAX_ITEMS_IN_MENU ? _current->childCount : MAX_ITEMS_IN_MENU;
+
+    PCD8544::FrameScope frame(*_lcd);
+    if (_shown != _current) {
+        _lcd->clear();
+        _lcd->drawStraightLine(0, 83, 10, true, 1);
+        _lcd->printStringCentered(_current->label, 0, true);
+        for (uint8_t r = 0; r < rows; r++) drawItem_(r, scroll, r == row);
+    } else if (scroll != _shownScroll) {
+        for (uint8_t r = 0; r < rows; r++) drawItem_(r, scroll, r == row);
+    } else if (row != _shownRow) {
+        drawItem_(_shownRow, scroll, false);
+        drawItem_(row, scroll, true);
     }
+    _shown = _current;
+    _shownScroll = scroll;
+    _shownRow = row;
+}
+
+// Ridisegna la riga row delle voci, azzerando le colonne non coperte dal testo
+void MenuController::drawItem_ (uint8_t row, uint8_t scroll, bool selected) {
+    const uint8_t page = (uint8_t)(row + FIRST_ITEM_ROW);
+    const char* label = _current->children[row + scroll].label;
+    auto blank = [](uint8_t, uint8_t) { return (uint8_t)0x00; };
+
+    if (!selected) _lcd->drawGenerated(0, page, ITEM_INDENT, 1, blank);
+    _lcd->setCursor(selected ? 0 : ITEM_INDENT, page);
+    if (selected) _lcd->print("> ");
+    _lcd->print(label);
+    const uint16_t end = (uint16_t)((selected ? _lcd->textWidth("> ") : ITEM_INDENT) + _lcd->textWidth(label));
+    if (end < COLUMNS) _lcd->drawGenerated((uint8_t)end, page, (uint8_t)(COLUMNS - end), 1, blank);
 }
 
 
 void MenuController::enterAction (Action& a) {
     _act = a;
     _mode = Mode::ACTION;
+    _shown = nullptr;   // la schermata dell'azione sostituisce il menu
     if (_act.onRender) _act.onRender();
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <stdint.h>
 #include <Arduino.h>
+#include "../io/buttons.h"
 
 class PCD8544;
 
@@ -54,36 +55,13 @@ struct MenuItem {
 class MenuController {
 public:
     MenuController (const MenuInputPins& pins)
-    : _pins(pins), _bBack(pins.backPin), _bFwd(pins.forwardPin), _bSel(pins.selectPin) {
-        // BACK
-        pinMode(pins.backPin,
-        pins.useInternalPull ?
-        #if defined(ARDUINO_ARCH_ESP32)
-          (pins.activeLow ? INPUT_PULLUP : INPUT_PULLDOWN)
-        #else
-          (pins.activeLow ? INPUT_PULLUP : INPUT)
-        #endif
-          : INPUT);
-
-        // FORWARD
-        pinMode(pins.forwardPin,
-        pins.useInternalPull ?
-        #if defined(ARDUINO_ARCH_ESP32)
-          (pins.activeLow ? INPUT_PULLUP : INPUT_PULLDOWN)
-        #else
-          (pins.activeLow ? INPUT_PULLUP : INPUT)
-        #endif
-          : INPUT);
-        
-        // SELECT
-        pinMode(pins.selectPin,
-        pins.useInternalPull ?
-        #if defined(ARDUINO_ARCH_ESP32)
-          (pins.activeLow ? INPUT_PULLUP : INPUT_PULLDOWN)
-        #else
-          (pins.activeLow ? INPUT_PULLUP : INPUT)
-        #endif
-          : INPUT);
+    : _pins(pins), _buttons({pins.backPin, pins.forwardPin, pins.selectPin}, pins.activeLow, pins.useInternalPull) {
+        pcd8544::ButtonTiming t;
+        t.debounceMs = pins.debounceMs;
+        _buttons.decoder().setTiming(t);
+        // avanti e indietro si ripetono tenendo premuto il pulsante
+        _buttons.decoder().setRepeat(BTN_BACK, true);
+        _buttons.decoder().setRepeat(BTN_FORWARD, true);
     }
 
     // MODALITA' AZIONE
@@ -99,6 +77,7 @@ public:
         _path[_depth] = root;
         _current = root;
         _cursor = 0;
+        _shown = nullptr;
     }
 
     inline bool select () {
@@ -148,9 +127,22 @@ public:
         }
     }
 
-    inline void update () { scanButtons_(); }
-    inline void attachDisplay (PCD8544* lcd) { _lcd = lcd; }
+    /*
+     *  update legge i pulsanti: al primo richiamo imposta i pin e collega gli interrupt (vedi io/buttons.h),
+     *  poi esegue le azioni degli eventi registrati dall'ultima chiamata, nell'ordine in cui sono avvenuti.
+     */
+    void update ();
+    // Tempi di debounce e ripetizione automatica (debounceMs sostituisce quello di MenuInputPins)
+    inline void setButtonTiming (const pcd8544::ButtonTiming& t) { _buttons.decoder().setTiming(t); }
+    inline void attachDisplay (PCD8544* lcd) { _lcd = lcd; _shown = nullptr; }
+    /*
+     *  displayMenu ridisegna solo ciò che è cambiato dall'ultima chiamata: le due righe della selezione se il
+     *  cursore si sposta nella finestra visibile, tutte le voci se la finestra scorre, l'intera schermata
+     *  (titolo e separatore compresi) solo entrando in un menu. Se lo schermo è stato modificato da altre
+     *  chiamate, invalidate() forza il ridisegno completo.
+     */
     void displayMenu ();
+    inline void invalidate () { _shown = nullptr; }
 
     void enterAction (Action& a);
     void exitAction ();
@@ -169,26 +161,17 @@ private:
     uint8_t _depth = 0;  // profondità del menu corrente (_current)
     uint8_t _cursor = 0; // Indice nel livello corrente
     PCD8544* _lcd = nullptr; // Puntatore all'istanza del display
+    const MenuItem* _shown = nullptr;   // menu disegnato sul display (nullptr: schermata da ridisegnare)
+    uint8_t _shownScroll = 0;   // prima voce visibile disegnata
+    uint8_t _shownRow = 0;      // riga della selezione disegnata
     enum class Mode {MENU, ACTION};
     Mode _mode = Mode::MENU;
     Action _act;
 
-    struct Btn {
-        bool state;
-        bool last;
-        unsigned long t;
-        uint8_t pin;
+    enum : uint8_t { BTN_BACK, BTN_FORWARD, BTN_SELECT };
+    pcd8544::ButtonInput<3> _buttons;
 
-        Btn (uint8_t p) : pin(p) {
-            state = false;
-            last = false;
-            t = 0;
-        };
-    };
-
-    Btn _bBack, _bFwd, _bSel;
-
-    void scanButtons_ ();
+    void drawItem_ (uint8_t row, uint8_t scroll, bool selected);
     inline void onPressBack_() { 
         if (_mode == Mode::MENU) { back(); displayMenu(); }
         else leftAction();